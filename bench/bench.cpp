@@ -0,0 +1,206 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "harness.h"
+
+#include "models.h"
+#include "scene.h"
+#include "animation.h"
+#include "camera.h"
+#include "soft_rasterizer.h"
+
+using namespace glm;
+
+#ifndef BENCH_BUILD_TYPE
+#define BENCH_BUILD_TYPE "unknown"
+#endif
+
+// ### MODELS ###
+
+static void bench_models(BenchmarkRunner& runner){
+    int seg8[] = {1,1,1,1,1,1,1};
+    runner.run("seven_seg_model", 7.0, [&](long long n){
+        for(long long i = 0; i < n; i++){
+            std::vector< mat4 > model = seven_seg_model(seg8);
+            do_not_optimize(model.data());
+        }
+    });
+
+    std::vector< mat4 > segments = seven_seg_model(seg8);
+    mat4 transform = translate(mat4(1.0f), vec3(1.0f, 2.0f, 3.0f));
+    runner.run("apply_transform_2_model", (double)segments.size(), [&](long long n){
+        for(long long i = 0; i < n; i++){
+            std::vector< mat4 > model = apply_transform_2_model(segments, transform);
+            do_not_optimize(model.data());
+        }
+    });
+
+    std::vector< std::vector< mat4 > > letters(4, segments);
+    runner.run("apply_transform_2_models", (double)(letters.size() * segments.size()), [&](long long n){
+        for(long long i = 0; i < n; i++){
+            std::vector< std::vector< mat4 > > models = apply_transform_2_models(letters, transform);
+            do_not_optimize(models.data());
+        }
+    });
+
+    runner.run("build_grid_model/128", 256.0, [&](long long n){
+        for(long long i = 0; i < n; i++){
+            std::vector< mat4 > grid = build_grid_model(128, 0.2f);
+            do_not_optimize(grid.data());
+        }
+    });
+
+    runner.run("build_scene", 0.0, [&](long long n){
+        for(long long i = 0; i < n; i++){
+            Scene scene;
+            build_scene(scene);
+            do_not_optimize(scene.list_letter_id.data());
+        }
+    });
+}
+
+// ### SCENE UPDATES ###
+
+static void bench_updates(BenchmarkRunner& runner){
+    // the 5 models of the scene, plus animated ones around the ring
+    const int extraModels[] = { 0, 100, 1000, 10000 };
+
+    for(int extra : extraModels){
+        Scene scene;
+        build_scene(scene);
+        AnimationSystem animation;
+        animate_ring_models(animation, add_ring_models(scene, extra), extra);
+
+        int models = (int)scene.list_letter_id.size();
+        std::string suffix = "/" + std::to_string(models);
+
+        runner.run("update_scene" + suffix, models, [&](long long n){
+            for(long long i = 0; i < n; i++){
+                update_scene(scene, 10.0f, 20.0f);
+            }
+            do_not_optimize(scene.list_letter_id.data());
+        });
+
+        if(extra > 0){
+            float time = 0.0f;
+            runner.run("animation_evaluate" + suffix, animation.channel_count(), [&](long long n){
+                for(long long i = 0; i < n; i++){
+                    time += 1.0f / 60.0f;
+                    animation.evaluate(time, scene.list_letter_id);
+                }
+                do_not_optimize(scene.list_letter_id.data());
+            });
+        }
+    }
+}
+
+// ### HEADLESS FRAMES ###
+
+static void bench_frames(BenchmarkRunner& runner){
+    // the whole frame of ass1 --software --animate 100 : animation, scene update, draw, rasterize
+    const int animatedModels = 100;
+    Scene scene;
+    build_scene(scene);
+    AnimationSystem animation;
+    animate_ring_models(animation, add_ring_models(scene, animatedModels), animatedModels);
+    update_scene(scene, 0.0f, 0.0f);
+
+    // same camera as ass1 --software, one thread so the numbers don't depend on the machine load
+    Camera camera(vec3(0.6f, 1.0f, 10.0f), 90.0f, 0.0f, 45.0f);
+    camera.set_framebuffer_size(1024, 768);
+
+    SoftwareRasterizer rasterizer(1024, 768, 1);
+    rasterizer.set_view_projection(camera.view_matrix(), camera.projection_matrix());
+
+    const RenderMode modes[] = { RENDER_FILL, RENDER_LINES, RENDER_POINTS };
+    const char* modeNames[] = { "fill", "lines", "points" };
+    for(int m = 0; m < 3; m++){
+        rasterizer.set_render_mode(modes[m]);
+        float time = 0.0f;
+        runner.run(std::string("software_frame/") + modeNames[m], 0.0, [&](long long n){
+            for(long long i = 0; i < n; i++){
+                time += 1.0f / 60.0f;
+                animation.evaluate(time, scene.list_letter_id);
+                update_scene(scene, 0.0f, 0.0f);
+
+                rasterizer.begin_frame();
+                draw_scene(scene, rasterizer);
+                rasterizer.end_frame();
+            }
+            do_not_optimize(rasterizer.color_buffer().data());
+        });
+    }
+}
+
+int main(int argc, char* argv[]){
+    std::string outputPath = "bench_results.json";
+    std::string baselinePath;
+    std::string filter;
+    double threshold = 0.30;
+    double minTimeMs = 50.0;
+    int samples = 5;
+    for(int i = 1; i < argc; i++){
+        if(strcmp(argv[i], "--out") == 0 && i + 1 < argc){
+            outputPath = argv[++i];
+        }
+        else if(strcmp(argv[i], "--baseline") == 0 && i + 1 < argc){
+            baselinePath = argv[++i];
+        }
+        else if(strcmp(argv[i], "--threshold") == 0 && i + 1 < argc){
+            threshold = std::atof(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--filter") == 0 && i + 1 < argc){
+            filter = argv[++i];
+        }
+        else if(strcmp(argv[i], "--min-time") == 0 && i + 1 < argc){
+            minTimeMs = std::atof(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--samples") == 0 && i + 1 < argc){
+            samples = std::atoi(argv[++i]);
+        }
+        else{
+            std::printf("usage: %s [--out results.json] [--baseline baseline.json] [--threshold 0.30] [--filter name] [--min-time ms] [--samples n]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::printf("### Benchmarks (%s build) ###\n", BENCH_BUILD_TYPE);
+    if(strcmp(BENCH_BUILD_TYPE, "Debug") == 0){
+        std::printf("warning : debug build, configure with -DCMAKE_BUILD_TYPE=Release for meaningful numbers\n");
+    }
+
+    BenchmarkRunner runner(minTimeMs, samples, filter);
+    bench_models(runner);
+    bench_updates(runner);
+    bench_frames(runner);
+
+    if(!runner.write_json(outputPath, BENCH_BUILD_TYPE)){
+        std::fprintf(stderr, "Failed to write %s\n", outputPath.c_str());
+        return 1;
+    }
+    std::printf("results written to %s\n", outputPath.c_str());
+
+    if(baselinePath.empty()){
+        return 0;
+    }
+
+    // asked for a comparison : without a baseline the check must not pass
+    std::vector< BenchmarkResult > baseline;
+    std::string baselineBuildType;
+    if(!read_results_json(baselinePath, baseline, baselineBuildType)){
+        std::fprintf(stderr, "No baseline at %s (record one with the bench_baseline target)\n", baselinePath.c_str());
+        return 1;
+    }
+    if(baselineBuildType != BENCH_BUILD_TYPE){
+        std::printf("warning : the baseline is a %s build, this is a %s build\n", baselineBuildType.c_str(), BENCH_BUILD_TYPE);
+    }
+
+    // non zero exit code -> the build / CI step fails
+    return (compare_results(runner.results(), baseline, threshold, filter) > 0) ? 1 : 0;
+}
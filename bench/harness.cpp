@@ -0,0 +1,216 @@
+#include "harness.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+// an external write through a volatile pointer : the value must exist
+static const void* volatile g_sink = nullptr;
+
+void do_not_optimize(const void* pointer){
+    g_sink = pointer;
+}
+
+static double ms_since(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double time_ms(const std::function< void(long long) >& body, long long iterations){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    body(iterations);
+    return ms_since(start);
+}
+
+// ### RUNNER ###
+
+BenchmarkRunner::BenchmarkRunner(double minTimeMs, int samples, const std::string& filter)
+    : m_minTimeMs(minTimeMs), m_samples(std::max(1, samples)), m_filter(filter)
+{
+}
+
+void BenchmarkRunner::run(const std::string& name, double itemsPerOp, const std::function< void(long long) >& body){
+    if(!m_filter.empty() && name.find(m_filter) == std::string::npos){
+        return;
+    }
+
+    // warm up (caches, allocations), then grow the iterations until a sample lasts minTimeMs
+    long long iterations = 1;
+    double elapsedMs = time_ms(body, iterations);
+    while(elapsedMs < m_minTimeMs){
+        double factor = (elapsedMs > 0.0) ? 1.2 * m_minTimeMs / elapsedMs : 10.0;
+        iterations = std::max(iterations + 1, (long long)(iterations * std::min(10.0, factor)));
+        elapsedMs = time_ms(body, iterations);
+    }
+
+    std::vector< double > samples;
+    for(int s = 0; s < m_samples; s++){
+        samples.push_back(time_ms(body, iterations) * 1.0e6 / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.nsPerOp = samples[samples.size() / 2];
+    result.minNsPerOp = samples[0];
+    result.itemsPerOp = itemsPerOp;
+    m_results.push_back(result);
+
+    std::printf("%-36s %12.1f ns/op (min %12.1f) %10lld iterations", name.c_str(), result.nsPerOp, result.minNsPerOp, iterations);
+    if(itemsPerOp > 0.0){
+        std::printf("  %10.3f M items/s", itemsPerOp * 1.0e3 / result.nsPerOp);
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+// ### JSON ###
+
+bool BenchmarkRunner::write_json(const std::string& path, const std::string& buildType) const{
+    std::ofstream file(path.c_str());
+    if(!file){
+        return false;
+    }
+
+    file << "{\n";
+    file << "  \"build_type\": \"" << buildType << "\",\n";
+    file << "  \"benchmarks\": [\n";
+    for(size_t i = 0; i < m_results.size(); i++){
+        const BenchmarkResult& result = m_results[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "    {\"name\": \"%s\", \"iterations\": %lld, \"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f, \"items_per_second\": %.1f}%s\n",
+                      result.name.c_str(), result.iterations, result.nsPerOp, result.minNsPerOp,
+                      (result.itemsPerOp > 0.0) ? result.itemsPerOp * 1.0e9 / result.nsPerOp : 0.0,
+                      (i + 1 < m_results.size()) ? "," : "");
+        file << line;
+    }
+    file << "  ]\n";
+    file << "}\n";
+    return (bool)file;
+}
+
+// value of "key": after position (string without escapes, or number)
+static bool find_value(const std::string& text, const std::string& key, size_t& position, std::string& value){
+    size_t found = text.find("\"" + key + "\"", position);
+    if(found == std::string::npos){
+        return false;
+    }
+    size_t start = text.find(':', found);
+    if(start == std::string::npos){
+        return false;
+    }
+    start = text.find_first_not_of(" \t\r\n", start + 1);
+    if(start == std::string::npos){
+        return false;
+    }
+
+    size_t end;
+    if(text[start] == '"'){
+        start++;
+        end = text.find('"', start);
+    }
+    else{
+        end = text.find_first_of(",}\r\n", start);
+    }
+    if(end == std::string::npos){
+        return false;
+    }
+
+    value = text.substr(start, end - start);
+    position = end;
+    return true;
+}
+
+bool read_results_json(const std::string& path, std::vector< BenchmarkResult >& results, std::string& buildType){
+    std::ifstream file(path.c_str());
+    if(!file){
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+
+    size_t position = 0;
+    std::string value;
+    buildType = find_value(text, "build_type", position, value) ? value : "";
+
+    // only what write_json() writes : one object per benchmark, name first
+    results.clear();
+    position = 0;
+    while(find_value(text, "name", position, value)){
+        BenchmarkResult result;
+        result.name = value;
+
+        size_t objectEnd = text.find('}', position);
+        size_t valuePosition = position;
+        if(find_value(text, "ns_per_op", valuePosition, value) && valuePosition <= objectEnd){
+            result.nsPerOp = std::atof(value.c_str());
+        }
+        valuePosition = position;
+        if(find_value(text, "min_ns_per_op", valuePosition, value) && valuePosition <= objectEnd){
+            result.minNsPerOp = std::atof(value.c_str());
+        }
+        results.push_back(result);
+        position = objectEnd;
+    }
+    return true;
+}
+
+// ### COMPARISON ###
+
+int compare_results(const std::vector< BenchmarkResult >& current, const std::vector< BenchmarkResult >& baseline, double threshold,
+                    const std::string& filter){
+    int regressions = 0;
+
+    std::printf("\n%-36s %14s %14s %9s\n", "benchmark (min)", "baseline ns", "current ns", "change");
+    for(size_t i = 0; i < current.size(); i++){
+        const BenchmarkResult& result = current[i];
+
+        const BenchmarkResult* reference = nullptr;
+        for(size_t j = 0; j < baseline.size(); j++){
+            if(baseline[j].name == result.name){
+                reference = &baseline[j];
+                break;
+            }
+        }
+
+        if(reference == nullptr || reference->minNsPerOp <= 0.0){
+            std::printf("%-36s %14s %14.1f %9s\n", result.name.c_str(), "-", result.minNsPerOp, "new");
+            continue;
+        }
+
+        // the fastest samples : the other ones mostly measure what else runs on the machine
+        double change = result.minNsPerOp / reference->minNsPerOp - 1.0;
+        bool regressed = change > threshold;
+        if(regressed){
+            regressions++;
+        }
+        std::printf("%-36s %14.1f %14.1f %+8.1f%%%s\n", result.name.c_str(), reference->minNsPerOp, result.minNsPerOp, change * 100.0,
+                    regressed ? "  REGRESSION" : "");
+    }
+
+    // a renamed or removed benchmark would hide its regression : it fails the check too
+    int missing = 0;
+    for(size_t j = 0; j < baseline.size(); j++){
+        const BenchmarkResult& reference = baseline[j];
+        if(!filter.empty() && reference.name.find(filter) == std::string::npos){
+            continue;
+        }
+
+        bool found = false;
+        for(size_t i = 0; i < current.size() && !found; i++){
+            found = (current[i].name == reference.name);
+        }
+        if(!found){
+            missing++;
+            std::printf("%-36s %14.1f %14s %9s  MISSING\n", reference.name.c_str(), reference.minNsPerOp, "-", "-");
+        }
+    }
+
+    std::printf("\n%d regression(s) above the %.1f%% threshold, %d baseline benchmark(s) missing\n", regressions, threshold * 100.0, missing);
+    return regressions + missing;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Small self contained benchmark harness : times each benchmark, writes the results as JSON
+// and compares them against a baseline written by a previous run.
+
+struct BenchmarkResult {
+    std::string name;
+    long long iterations = 0; // per sample
+    double nsPerOp = 0.0;     // median of the samples
+    double minNsPerOp = 0.0;
+    double itemsPerOp = 0.0;  // models, channels, frames ... (0 -> no items/s)
+};
+
+class BenchmarkRunner {
+public:
+    // each sample runs for about minTimeMs, only the benchmarks whose name contains filter run
+    BenchmarkRunner(double minTimeMs = 50.0, int samples = 5, const std::string& filter = "");
+
+    // body(n) runs the measured operation n times
+    void run(const std::string& name, double itemsPerOp, const std::function< void(long long) >& body);
+
+    const std::vector< BenchmarkResult >& results() const { return m_results; }
+
+    bool write_json(const std::string& path, const std::string& buildType) const;
+
+private:
+    double m_minTimeMs;
+    int m_samples;
+    std::string m_filter;
+    std::vector< BenchmarkResult > m_results;
+};
+
+// read a file written by write_json() (returns false if it can't be read)
+bool read_results_json(const std::string& path, std::vector< BenchmarkResult >& results, std::string& buildType);
+
+// print current vs baseline (fastest samples), returns the number of benchmarks slower than baseline * (1 + threshold)
+// plus the number of baseline benchmarks matching filter that did not run (renamed or removed)
+int compare_results(const std::vector< BenchmarkResult >& current, const std::vector< BenchmarkResult >& baseline, double threshold,
+                    const std::string& filter = "");
+
+// keep the compiler from removing a computation whose result is unused
+void do_not_optimize(const void* pointer);
+
+template< typename T >
+void do_not_optimize(const T& value){
+    do_not_optimize(static_cast< const void* >(&value));
+}
@@ -0,0 +1,322 @@
+#include "animation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using namespace glm;
+
+static double ms_since(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ### CURVES ###
+
+// slope of a smooth curve at key i : Catmull-Rom, limited so the cubic doesn't overshoot the keys
+// (flat at a local min / max or next to a flat segment, so a hold between two equal keys stays exactly flat)
+static float key_slope(const AnimationCurve& curve, int i){
+    const std::vector< Keyframe >& keys = curve.keys;
+    int count = (int)keys.size();
+    bool wraps = curve.loop && count > 2;
+
+    // a looping curve continues on the other side, shifted by what one loop adds (0 -> 360 : the key before 0 is 360 - 360)
+    float loopOffset = keys[count - 1].value - keys[0].value;
+    float loopDuration = keys[count - 1].time - keys[0].time;
+
+    bool hasBefore = (i > 0) || wraps;
+    bool hasAfter = (i + 1 < count) || wraps;
+    Keyframe before = (i > 0) ? keys[i - 1] : Keyframe{ keys[count - 2].time - loopDuration, keys[count - 2].value - loopOffset };
+    Keyframe after = (i + 1 < count) ? keys[i + 1] : Keyframe{ keys[1].time + loopDuration, keys[1].value + loopOffset };
+
+    float slopeBefore = hasBefore ? (keys[i].value - before.value) / (keys[i].time - before.time) : 0.0f;
+    float slopeAfter = hasAfter ? (after.value - keys[i].value) / (after.time - keys[i].time) : 0.0f;
+    if(!hasBefore){
+        return slopeAfter;
+    }
+    if(!hasAfter){
+        return slopeBefore;
+    }
+    if(slopeBefore * slopeAfter <= 0.0f){
+        return 0.0f;
+    }
+
+    // at most 3x the smaller neighbour segment slope -> monotone between the keys
+    float slope = (after.value - before.value) / (after.time - before.time);
+    float limit = 3.0f * std::min(std::abs(slopeBefore), std::abs(slopeAfter));
+    return std::max(-limit, std::min(slope, limit));
+}
+
+// value of the curve at a time inside [first key, last key]
+static float sample_keys(const AnimationCurve& curve, float time){
+    const std::vector< Keyframe >& keys = curve.keys;
+    int count = (int)keys.size();
+    if(count == 1 || time <= keys[0].time){
+        return keys[0].value;
+    }
+    if(time >= keys[count - 1].time){
+        return keys[count - 1].value;
+    }
+
+    // segment [k, k + 1] containing the time
+    int k = 0;
+    while(k + 2 < count && keys[k + 1].time <= time){
+        k++;
+    }
+
+    const Keyframe& from = keys[k];
+    const Keyframe& to = keys[k + 1];
+    float length = to.time - from.time;
+    if(curve.interpolation == CURVE_STEP || length <= 0.0f){
+        return from.value;
+    }
+
+    float t = (time - from.time) / length;
+    if(curve.interpolation == CURVE_LINEAR){
+        return from.value + (to.value - from.value) * t;
+    }
+
+    float slopeFrom = key_slope(curve, k);
+    float slopeTo = key_slope(curve, k + 1);
+
+    // cubic hermite, written from the first key so a flat segment returns it exactly
+    float t2 = t * t;
+    float t3 = t2 * t;
+    float value = from.value + (-2.0f * t3 + 3.0f * t2) * (to.value - from.value) +
+                  (t3 - 2.0f * t2 + t) * length * slopeFrom + (t3 - t2) * length * slopeTo;
+
+    // the limited slopes keep it between the two keys, this only removes the rounding
+    return std::min(std::max(value, std::min(from.value, to.value)), std::max(from.value, to.value));
+}
+
+float evaluate_curve(const AnimationCurve& curve, float time){
+    float startTime = curve.keys.front().time;
+    float duration = curve.keys.back().time - startTime;
+    if(curve.loop && duration > 0.0f){
+        time = startTime + (time - startTime) - std::floor((time - startTime) / duration) * duration;
+    }
+    return sample_keys(curve, time);
+}
+
+// segments of the coarsest regular grid with a line on every key (snapError > 0 : no such grid up to maxSegments)
+static int key_grid_segments(const AnimationCurve& curve, int maxSegments, float& snapError){
+    const std::vector< Keyframe >& keys = curve.keys;
+    float startTime = keys.front().time;
+    float duration = keys.back().time - startTime;
+    snapError = 0.0f;
+    if(duration <= 0.0f){
+        return 1;
+    }
+
+    // at least one segment per key span
+    float minSpacing = duration;
+    for(size_t k = 1; k < keys.size(); k++){
+        float spacing = keys[k].time - keys[k - 1].time;
+        if(spacing > 0.0f){
+            minSpacing = std::min(minSpacing, spacing);
+        }
+    }
+    int first = std::max(1, (int)std::ceil(duration / minSpacing - 1.0e-3f));
+
+    for(int segments = first; segments <= maxSegments; segments++){
+        float worst = 0.0f;
+        for(size_t k = 0; k < keys.size(); k++){
+            float position = (keys[k].time - startTime) * segments / duration;
+            worst = std::max(worst, std::abs(position - std::round(position)));
+        }
+        if(worst <= 1.0e-3f || segments == maxSegments){
+            snapError = (worst <= 1.0e-3f) ? 0.0f : worst * duration / segments;
+            return segments;
+        }
+    }
+    snapError = duration / maxSegments;
+    return maxSegments;
+}
+
+int AnimationSystem::add_curve(const AnimationCurve& curve){
+    float startTime = curve.keys.front().time;
+    float duration = curve.keys.back().time - startTime;
+    bool step = (curve.interpolation == CURVE_STEP);
+
+    float snapError = 0.0f;
+    int segments = key_grid_segments(curve, maxKeyGridSegments, snapError);
+    if(snapError > 0.0f){
+        std::printf("Animation : the keys of curve %d are not on a grid of %d segments, they snap by up to %.3f ms\n",
+                    (int)m_curveRates.size(), segments, snapError * 1000.0f);
+    }
+    if(curve.interpolation == CURVE_SMOOTH){
+        segments *= smoothSubdivisions;
+    }
+
+    m_curveSampleOffsets.push_back((int)m_samples.size());
+    for(int i = 0; i <= segments; i++){
+        if(step && i < segments){
+            // middle of the segment : the keys are on the segment ends
+            m_samples.push_back(sample_keys(curve, startTime + duration * (i + 0.5f) / segments));
+        }
+        else{
+            // the last sample is the last key (not wrapped) : a 0 -> 360 loop interpolates up to 360, then starts again at 0
+            m_samples.push_back(sample_keys(curve, startTime + duration * i / segments));
+        }
+    }
+
+    // a single key (or keys at the same time) is constant
+    m_curveSegments.push_back(segments);
+    m_curveRates.push_back(duration > 0.0f ? segments / duration : 0.0f);
+    m_curveStartTimes.push_back(startTime);
+    m_curveLoops.push_back(curve.loop);
+    m_curveSteps.push_back(step);
+    return (int)m_curveRates.size() - 1;
+}
+
+// ### CHANNELS ###
+
+void AnimationSystem::animate(int modelIndex, Channel channel, int curve, float speed, float phase){
+    ChannelGroup& group = m_curveSteps[curve] ? m_stepGroups[channel] : m_groups[channel];
+    float curveRate = m_curveRates[curve];
+
+    group.models.push_back(modelIndex);
+    group.sampleOffsets.push_back(m_curveSampleOffsets[curve]);
+    group.segments.push_back((float)m_curveSegments[curve]);
+    group.invSegments.push_back(1.0f / m_curveSegments[curve]);
+    group.rates.push_back(curveRate * speed);
+    group.phases.push_back((phase - m_curveStartTimes[curve]) * curveRate);
+    group.loops.push_back(m_curveLoops[curve] ? 1.0f : 0.0f);
+    group.values.push_back(0.0f);
+
+    m_stats.channels++;
+}
+
+void AnimationSystem::clear_channels(){
+    for(int channel = 0; channel < CHANNEL_COUNT; channel++){
+        m_groups[channel] = ChannelGroup();
+        m_stepGroups[channel] = ChannelGroup();
+    }
+    m_stats.channels = 0;
+}
+
+int AnimationSystem::channel_count() const{
+    return m_stats.channels;
+}
+
+// ### EVALUATION ###
+
+void AnimationSystem::evaluate_group(ChannelGroup& group, float time){
+    const float* samples = m_samples.data();
+    const int* sampleOffsets = group.sampleOffsets.data();
+    const float* segments = group.segments.data();
+    const float* invSegments = group.invSegments.data();
+    const float* rates = group.rates.data();
+    const float* phases = group.phases.data();
+    const float* loops = group.loops.data();
+    float* values = group.values.data();
+    int count = (int)group.values.size();
+
+    // same instructions for every channel (no branch, no search) -> the compiler can vectorize it
+    for(int c = 0; c < count; c++){
+        float s = time * rates[c] + phases[c];
+
+        // loop : wrap into [0, segments), hold : clamp into [0, segments]
+        float wrapped = s - std::floor(s * invSegments[c]) * segments[c];
+        float clamped = std::min(std::max(s, 0.0f), segments[c]);
+        s = clamped + (wrapped - clamped) * loops[c];
+
+        float i = std::min(std::floor(s), segments[c] - 1.0f);
+        float f = s - i;
+        const float* sample = samples + sampleOffsets[c] + (int)i;
+        values[c] = sample[0] + (sample[1] - sample[0]) * f;
+    }
+}
+
+void AnimationSystem::evaluate_step_group(ChannelGroup& group, float time){
+    const float* samples = m_samples.data();
+    const int* sampleOffsets = group.sampleOffsets.data();
+    const float* segments = group.segments.data();
+    const float* invSegments = group.invSegments.data();
+    const float* rates = group.rates.data();
+    const float* phases = group.phases.data();
+    const float* loops = group.loops.data();
+    float* values = group.values.data();
+    int count = (int)group.values.size();
+
+    // the value of the segment containing the time, no lerp (the last sample is the held last key)
+    for(int c = 0; c < count; c++){
+        float s = time * rates[c] + phases[c];
+
+        float wrapped = s - std::floor(s * invSegments[c]) * segments[c];
+        float clamped = std::min(std::max(s, 0.0f), segments[c]);
+        s = clamped + (wrapped - clamped) * loops[c];
+
+        values[c] = samples[sampleOffsets[c] + (int)std::floor(s)];
+    }
+}
+
+// write the values of a group where update_scene() reads them
+static void write_values(const std::vector< int >& models, const std::vector< float >& values,
+                         std::vector< LetterIDModel >& targets, float LetterIDModel::* member){
+    for(size_t c = 0; c < values.size(); c++){
+        targets[models[c]].*member = values[c];
+    }
+}
+
+void AnimationSystem::evaluate(float time, std::vector< LetterIDModel >& models){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for(int channel = 0; channel < CHANNEL_COUNT; channel++){
+        evaluate_group(m_groups[channel], time);
+        evaluate_step_group(m_stepGroups[channel], time);
+    }
+
+    float LetterIDModel::* targets[CHANNEL_COUNT] = { &LetterIDModel::orbitAngle, &LetterIDModel::spinAngle, &LetterIDModel::pulseScale };
+    for(int channel = 0; channel < CHANNEL_COUNT; channel++){
+        write_values(m_groups[channel].models, m_groups[channel].values, models, targets[channel]);
+        write_values(m_stepGroups[channel].models, m_stepGroups[channel].values, models, targets[channel]);
+    }
+
+    m_stats.lastEvaluateMs = ms_since(start);
+    m_stats.evaluateMs += m_stats.lastEvaluateMs;
+    m_stats.evaluatedChannels += m_stats.channels;
+}
+
+void AnimationSystem::print_stats() const{
+    double channelsPerSecond = (m_stats.evaluateMs > 0.0) ? m_stats.evaluatedChannels / (m_stats.evaluateMs * 0.001) : 0.0;
+
+    std::printf("### Animation (%d curves, %d samples) ###\n", (int)m_curveRates.size(), (int)m_samples.size());
+    std::printf("  channels     : %d (%d orbit, %d spin, %d scale, %d of them step)\n", m_stats.channels,
+                (int)(m_groups[CHANNEL_ORBIT].values.size() + m_stepGroups[CHANNEL_ORBIT].values.size()),
+                (int)(m_groups[CHANNEL_SPIN].values.size() + m_stepGroups[CHANNEL_SPIN].values.size()),
+                (int)(m_groups[CHANNEL_SCALE].values.size() + m_stepGroups[CHANNEL_SCALE].values.size()),
+                (int)(m_stepGroups[CHANNEL_ORBIT].values.size() + m_stepGroups[CHANNEL_SPIN].values.size() + m_stepGroups[CHANNEL_SCALE].values.size()));
+    std::printf("  evaluate     : %.3f ms last frame, %lld channels in %.3f ms\n", m_stats.lastEvaluateMs, m_stats.evaluatedChannels, m_stats.evaluateMs);
+    std::printf("  throughput   : %.2f Mchannels/s\n", channelsPerSecond * 1e-6);
+}
+
+// ### RING ###
+
+void animate_ring_models(AnimationSystem& animation, int firstModel, int count){
+    // one turn around the ring per minute
+    AnimationCurve orbitCurve;
+    orbitCurve.keys = { {0.0f, 0.0f}, {60.0f, 360.0f} };
+    int orbit = animation.add_curve(orbitCurve);
+
+    // half turns in place with a short stop after each
+    AnimationCurve spinCurve;
+    spinCurve.interpolation = CURVE_SMOOTH;
+    spinCurve.keys = { {0.0f, 0.0f}, {1.5f, 180.0f}, {2.0f, 180.0f}, {3.5f, 360.0f}, {4.0f, 360.0f} };
+    int spin = animation.add_curve(spinCurve);
+
+    // pulse once per second
+    AnimationCurve pulseCurve;
+    pulseCurve.interpolation = CURVE_SMOOTH;
+    pulseCurve.keys = { {0.0f, 1.0f}, {0.3f, 1.25f}, {1.0f, 1.0f} };
+    int pulse = animation.add_curve(pulseCurve);
+
+    for(int i = 0; i < count; i++){
+        int model = firstModel + i;
+        animation.animate(model, AnimationSystem::CHANNEL_ORBIT, orbit);
+
+        // the phases make a wave travel along the ring
+        animation.animate(model, AnimationSystem::CHANNEL_SPIN, spin, 1.0f, i * 0.1f);
+        animation.animate(model, AnimationSystem::CHANNEL_SCALE, pulse, 1.0f, i * 0.05f);
+    }
+}
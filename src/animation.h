@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "models.h"
+
+// Keyframe of a curve : value at a time (seconds)
+struct Keyframe {
+    float time;
+    float value;
+};
+
+enum CurveInterpolation {
+    CURVE_STEP,   // hold the value of the previous key
+    CURVE_LINEAR,
+    CURVE_SMOOTH  // cubic through the keys (Catmull-Rom tangents, limited so it doesn't overshoot)
+};
+
+struct AnimationCurve {
+    std::vector< Keyframe > keys; // sorted by time
+    CurveInterpolation interpolation = CURVE_LINEAR;
+    bool loop = true;             // repeat after the last key, otherwise hold it
+};
+
+// Animates the letter/id models with keyframe curves. Three channels per model feed the transform stage
+// (update_scene()) : the orbit around the ring center, the rotation in place and a scale pulse.
+//
+// The curves are resampled once into tables, so evaluating a channel is the same branch free work for any curve :
+// wrap / clamp the time, look up two samples, lerp. A table is sized from the keys so that every key falls on a
+// sample (finer for the smooth curves), step curves keep their own groups that read one sample without the lerp :
+// they jump exactly at their keys. The channels are stored as structure of arrays, one group per target (and
+// interpolated / step), and evaluated in one tight loop per group over all the models.
+class AnimationSystem {
+public:
+    enum Channel {
+        CHANNEL_ORBIT, // degrees around the y axis through the ring center -> LetterIDModel::orbitAngle
+        CHANNEL_SPIN,  // degrees around the model center                   -> LetterIDModel::spinAngle
+        CHANNEL_SCALE, // factor around the model center                    -> LetterIDModel::pulseScale
+        CHANNEL_COUNT
+    };
+
+    struct Stats {
+        int channels = 0;
+        long long evaluatedChannels = 0; // since the start
+        double evaluateMs = 0.0;         // since the start
+        double lastEvaluateMs = 0.0;
+    };
+
+    // segments of a smooth curve between two samples on the key grid
+    static const int smoothSubdivisions = 32;
+
+    // finest key grid searched : keys that don't fall on a grid up to this size snap to it (with a warning)
+    static const int maxKeyGridSegments = 4096;
+
+    // returns the curve index (keys must not be empty)
+    int add_curve(const AnimationCurve& curve);
+
+    // drive a channel of a model with a curve, speed scales the time, phase (seconds) offsets it
+    void animate(int modelIndex, Channel channel, int curve, float speed = 1.0f, float phase = 0.0f);
+
+    // remove every channel (the curves are kept)
+    void clear_channels();
+
+    int channel_count() const;
+
+    // evaluate every channel at the given time (seconds) and write the results into the models
+    void evaluate(float time, std::vector< LetterIDModel >& models);
+
+    const Stats& stats() const { return m_stats; }
+    void print_stats() const;
+
+private:
+    struct ChannelGroup {
+        std::vector< int > models;
+        std::vector< int > sampleOffsets; // first sample of the curve in m_samples
+        std::vector< float > segments;    // of the curve table
+        std::vector< float > invSegments;
+        std::vector< float > rates;       // samples per second (speed included)
+        std::vector< float > phases;      // in samples
+        std::vector< float > loops;       // 1 loop, 0 hold the last key
+        std::vector< float > values;
+    };
+
+    void evaluate_group(ChannelGroup& group, float time);
+    void evaluate_step_group(ChannelGroup& group, float time);
+
+    // segments + 1 samples per curve, the last one closes the last segment
+    std::vector< float > m_samples;
+    std::vector< int > m_curveSampleOffsets;
+    std::vector< int > m_curveSegments;
+    std::vector< float > m_curveRates;     // samples per second at speed 1
+    std::vector< float > m_curveStartTimes;
+    std::vector< bool > m_curveLoops;
+    std::vector< bool > m_curveSteps;
+
+    ChannelGroup m_groups[CHANNEL_COUNT];     // linear and smooth curves
+    ChannelGroup m_stepGroups[CHANNEL_COUNT]; // step curves
+    Stats m_stats;
+};
+
+// evaluate a curve at a time directly from its keys (what the tables are resampled from)
+float evaluate_curve(const AnimationCurve& curve, float time);
+
+// orbit along the ring, spin in place and pulse for the models [firstModel, firstModel + count)
+void animate_ring_models(AnimationSystem& animation, int firstModel, int count);
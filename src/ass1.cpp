@@ -1,7 +1,11 @@
 #include <iostream>
 #include <cstring>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
 #include <vector>
 #include <list>
+#include <thread>
 
 #define GLEW_STATIC 1   // This allows linking with Static Library on Windows, without DLL
 #include <GL/glew.h>    // Include GLEW - OpenGL Extension Wrangler
@@ -13,30 +17,24 @@
 #include <glm/gtc/matrix_transform.hpp> // include this to create transformation matrices
 #include <glm/common.hpp>
 
+#include "models.h"
+#include "glyph_cache.h"
+#include "scene.h"
+#include "program_cache.h"
+#include "startup_stats.h"
+#include "render_backend.h"
+#include "gl_backend.h"
+#include "soft_rasterizer.h"
+#include "multi_view.h"
+#include "camera.h"
+#include "occlusion.h"
+#include "animation.h"
+#include "frame_pacing.h"
+#include "telemetry.h"
+
 using namespace glm;
 using namespace std;
 
-// Structs.
-struct LetterIDModel {
-    std::vector<std::vector< mat4 >> m_letter_id_matrix;
-    std::vector<std::vector< mat4 >> og_letter_id_matrix;
-
-    // we need to apply the transform on the original matrix of the model (if use on the m_letter_id_matrix -> effect will be compounded)
-    // hence why we have a og matrix
-    
-    // params
-    float scale = 1.0f;
-    float x = 0.0f;
-    float y = 0.0f;
-    float z = 0.0f;
-    float angle = 1.0f;
-
-    LetterIDModel(std::vector<std::vector< mat4 >> letter_id_matrix){
-        m_letter_id_matrix = letter_id_matrix;
-        og_letter_id_matrix = letter_id_matrix;
-    }
-};
-
 const char* getVertexShaderSource()
 {
     // For now, you use a string for your shader code, in the assignment, shaders will be stored in .glsl files
@@ -49,12 +47,37 @@ const char* getVertexShaderSource()
                 "uniform mat4 viewMatrix = mat4(1.0);"  // default value for view matrix (identity)
                 "uniform mat4 projectionMatrix = mat4(1.0);"
                 ""
+                // multi view : instance i is drawn in the view viewIndices[i] (see GLRenderBackend::draw_cube_views)
+                "uniform int multiViewEnabled = 0;"
+                "uniform int viewIndices[4];"
+                "uniform mat4 viewProjections[4];"
+                "uniform vec4 viewRects[4];"  // x, y, width, height of the view in NDC of the whole framebuffer
+                ""
                 "out vec3 vertexColor;"
+                "out float gl_ClipDistance[4];"
                 "void main()"
                 "{"
                 "   vertexColor = aColor;"
-                "   mat4 modelViewProjection = projectionMatrix * viewMatrix * worldMatrix;"
-                "   gl_Position = modelViewProjection * vec4(aPos.x, aPos.y, aPos.z, 1.0);"
+                "   if (multiViewEnabled == 0)"
+                "   {"
+                "       mat4 modelViewProjection = projectionMatrix * viewMatrix * worldMatrix;"
+                "       gl_Position = modelViewProjection * vec4(aPos.x, aPos.y, aPos.z, 1.0);"
+                "       gl_ClipDistance[0] = gl_ClipDistance[1] = gl_ClipDistance[2] = gl_ClipDistance[3] = 1.0;"
+                "   }"
+                "   else"
+                "   {"
+                "       int view = viewIndices[gl_InstanceID];"
+                "       vec4 clip = viewProjections[view] * worldMatrix * vec4(aPos.x, aPos.y, aPos.z, 1.0);"
+                ""
+                        // the sides of the view frustum clip the view rectangle, then remap [-1, 1] to the rectangle
+                "       gl_ClipDistance[0] = clip.w + clip.x;"
+                "       gl_ClipDistance[1] = clip.w - clip.x;"
+                "       gl_ClipDistance[2] = clip.w + clip.y;"
+                "       gl_ClipDistance[3] = clip.w - clip.y;"
+                "       vec4 rect = viewRects[view];"
+                "       clip.xy = clip.xy * (rect.zw * 0.5) + (rect.xy + rect.zw * 0.5) * clip.w;"
+                "       gl_Position = clip;"
+                "   }"
                 "}";
 }
 
@@ -78,7 +101,7 @@ int compileAndLinkShaders()
     // ------------------------------------
 
     // vertex shader
-    int vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    int vertexShader = tracked_create_shader(GL_VERTEX_SHADER);
     const char* vertexShaderSource = getVertexShaderSource();
     glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
     glCompileShader(vertexShader);
@@ -94,7 +117,7 @@ int compileAndLinkShaders()
     }
     
     // fragment shader
-    int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    int fragmentShader = tracked_create_shader(GL_FRAGMENT_SHADER);
     const char* fragmentShaderSource = getFragmentShaderSource();
     glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
     glCompileShader(fragmentShader);
@@ -108,9 +131,13 @@ int compileAndLinkShaders()
     }
     
     // link shaders
-    int shaderProgram = glCreateProgram();
+    int shaderProgram = tracked_create_program();
     glAttachShader(shaderProgram, vertexShader);
     glAttachShader(shaderProgram, fragmentShader);
+    if (program_binary_supported())
+    {
+        glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE); // needed by save_program_binary
+    }
     glLinkProgram(shaderProgram);
     
     // check for linking errors
@@ -120,293 +147,242 @@ int compileAndLinkShaders()
         std::cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
     }
     
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    tracked_delete_shader(vertexShader);
+    tracked_delete_shader(fragmentShader);
     
     return shaderProgram;
 }
 
-int createVertexBufferObject(bool multiColorFlag, vec3 colorVect)
+// input events, timed by the frame pacer (input -> swap latency)
+void keyCallback(GLFWwindow* window, int /*key*/, int /*scancode*/, int action, int /*mods*/)
 {
-    vec3 whiteVect = vec3(1.0f, 1.0f, 1.0f);
-    vec3 redVect = vec3(1.0f, 0.0f, 0.0f);
-    vec3 greenVect = vec3(0.0f, 1.0f, 0.0f);
-    vec3 blueVect = vec3(0.0f, 0.0f, 1.0f);
-
-    vec3 yellowVect = vec3(1.0f, 1.0f, 0.0f);
-    vec3 lightBlueVect = vec3(0.0f, 1.0f, 1.0f);
-    vec3 pinkVect = vec3(1.0f, 0.0f, 1.0f);
-
-    // Cube model
-    vec3 specifiedColorVertexArray[] = {  // position,                            color
-        vec3(-0.5f,-0.5f,-0.5f), colorVect,
-        vec3(-0.5f,-0.5f, 0.5f), colorVect,
-        vec3(-0.5f, 0.5f, 0.5f), colorVect,
-        
-        vec3(-0.5f,-0.5f,-0.5f), colorVect,
-        vec3(-0.5f, 0.5f, 0.5f), colorVect,
-        vec3(-0.5f, 0.5f,-0.5f), colorVect,
-        
-        vec3( 0.5f, 0.5f,-0.5f), colorVect,
-        vec3(-0.5f,-0.5f,-0.5f), colorVect,
-        vec3(-0.5f, 0.5f,-0.5f), colorVect,
-        
-        vec3( 0.5f, 0.5f,-0.5f), colorVect,
-        vec3( 0.5f,-0.5f,-0.5f), colorVect,
-        vec3(-0.5f,-0.5f,-0.5f), colorVect,
-        
-        vec3( 0.5f,-0.5f, 0.5f), colorVect,
-        vec3(-0.5f,-0.5f,-0.5f), colorVect,
-        vec3( 0.5f,-0.5f,-0.5f), colorVect,
-        
-        vec3( 0.5f,-0.5f, 0.5f), colorVect,
-        vec3(-0.5f,-0.5f, 0.5f), colorVect,
-        vec3(-0.5f,-0.5f,-0.5f), colorVect,
-        
-        vec3(-0.5f, 0.5f, 0.5f), colorVect,
-        vec3(-0.5f,-0.5f, 0.5f), colorVect,
-        vec3( 0.5f,-0.5f, 0.5f), colorVect,
-        
-        vec3( 0.5f, 0.5f, 0.5f), colorVect,
-        vec3(-0.5f, 0.5f, 0.5f), colorVect,
-        vec3( 0.5f,-0.5f, 0.5f), colorVect,
-        
-        vec3( 0.5f, 0.5f, 0.5f), colorVect,
-        vec3( 0.5f,-0.5f,-0.5f), colorVect,
-        vec3( 0.5f, 0.5f,-0.5f), colorVect,
-        
-        vec3( 0.5f,-0.5f,-0.5f), colorVect,
-        vec3( 0.5f, 0.5f, 0.5f), colorVect,
-        vec3( 0.5f,-0.5f, 0.5f), colorVect,
-        
-        vec3( 0.5f, 0.5f, 0.5f), colorVect,
-        vec3( 0.5f, 0.5f,-0.5f), colorVect,
-        vec3(-0.5f, 0.5f,-0.5f), colorVect,
-        
-        vec3( 0.5f, 0.5f, 0.5f), colorVect,
-        vec3(-0.5f, 0.5f,-0.5f), colorVect,
-        vec3(-0.5f, 0.5f, 0.5f), colorVect
-    };
-
-    vec3 colorVertexArray[] = {  // position,                            color
-        vec3(-0.5f,-0.5f,-0.5f), redVect, //left - red
-        vec3(-0.5f,-0.5f, 0.5f), redVect,
-        vec3(-0.5f, 0.5f, 0.5f), redVect,
-        
-        vec3(-0.5f,-0.5f,-0.5f), redVect,
-        vec3(-0.5f, 0.5f, 0.5f), redVect,
-        vec3(-0.5f, 0.5f,-0.5f), redVect,
-        
-        vec3( 0.5f, 0.5f,-0.5f), blueVect,
-        vec3(-0.5f,-0.5f,-0.5f), blueVect,
-        vec3(-0.5f, 0.5f,-0.5f), blueVect,
-        
-        vec3( 0.5f, 0.5f,-0.5f), blueVect,
-        vec3( 0.5f,-0.5f,-0.5f), blueVect,
-        vec3(-0.5f,-0.5f,-0.5f), blueVect,
-        
-        vec3( 0.5f,-0.5f, 0.5f), greenVect, 
-        vec3(-0.5f,-0.5f,-0.5f), greenVect, 
-        vec3( 0.5f,-0.5f,-0.5f), greenVect, 
-        
-        vec3( 0.5f,-0.5f, 0.5f), greenVect, 
-        vec3(-0.5f,-0.5f, 0.5f), greenVect, 
-        vec3(-0.5f,-0.5f,-0.5f), greenVect, 
-        
-        vec3(-0.5f, 0.5f, 0.5f), yellowVect, 
-        vec3(-0.5f,-0.5f, 0.5f), yellowVect, 
-        vec3( 0.5f,-0.5f, 0.5f), yellowVect, 
-        
-        vec3( 0.5f, 0.5f, 0.5f), yellowVect, 
-        vec3(-0.5f, 0.5f, 0.5f), yellowVect, 
-        vec3( 0.5f,-0.5f, 0.5f), yellowVect, 
-        
-        vec3( 0.5f, 0.5f, 0.5f), pinkVect,
-        vec3( 0.5f,-0.5f,-0.5f), pinkVect,
-        vec3( 0.5f, 0.5f,-0.5f), pinkVect,
-        
-        vec3( 0.5f,-0.5f,-0.5f), pinkVect,
-        vec3( 0.5f, 0.5f, 0.5f), pinkVect,
-        vec3( 0.5f,-0.5f, 0.5f), pinkVect,
-        
-        vec3( 0.5f, 0.5f, 0.5f), lightBlueVect,
-        vec3( 0.5f, 0.5f,-0.5f), lightBlueVect,
-        vec3(-0.5f, 0.5f,-0.5f), lightBlueVect,
-        
-        vec3( 0.5f, 0.5f, 0.5f), lightBlueVect,
-        vec3(-0.5f, 0.5f,-0.5f), lightBlueVect,
-        vec3(-0.5f, 0.5f, 0.5f), lightBlueVect
-    };
-
-    // either choose the multi-color or single color cube
-    vec3 vertexArray[72] = {};
-    if(multiColorFlag){
-        std::memcpy(vertexArray, colorVertexArray, sizeof(colorVertexArray));
-    }
-    else{
-        std::memcpy(vertexArray, specifiedColorVertexArray, sizeof(specifiedColorVertexArray));
+    if (action != GLFW_RELEASE)
+    {
+        static_cast< FramePacer* >(glfwGetWindowUserPointer(window))->input_received();
     }
-    
-    // Create a vertex array
-    GLuint vertexArrayObject;
-    glGenVertexArrays(1, &vertexArrayObject);
-    glBindVertexArray(vertexArrayObject);
-    
-    // Upload Vertex Buffer to the GPU, keep a reference to it (vertexBufferObject)
-    GLuint vertexBufferObject;
-    glGenBuffers(1, &vertexBufferObject);
-    glBindBuffer(GL_ARRAY_BUFFER, vertexBufferObject);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertexArray), vertexArray, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0,                   // attribute 0 matches aPos in Vertex Shader
-                          3,                   // size
-                          GL_FLOAT,            // type
-                          GL_FALSE,            // normalized?
-                          2*sizeof(vec3), // stride - each vertex contain 2 vec3 (position, color)
-                          (void*)0             // array buffer offset
-                          );
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1,                            // attribute 1 matches aColor in Vertex Shader
-                          3,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          2*sizeof(vec3),
-                          (void*)sizeof(vec3)      // color is offseted a vec3 (comes after position)
-                          );
-    glEnableVertexAttribArray(1);
-    
-    return vertexBufferObject;
-}
-
-// ### DRAWING HELPER FUNCTIONS ###
-
-// draw the given matrix
-void draw_matrix(mat4 matrix, GLuint worldMatrixLocation){
-    glUniformMatrix4fv(worldMatrixLocation, 1, GL_FALSE, &matrix[0][0]);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
 }
 
-// draw the given list of matrix
-void draw_model(std::vector< mat4 > matrixList, GLuint worldMatrixLocation){
-    // Declaring iterator to a vector 
-    std::vector< mat4 >::iterator ptr; 
-      
-    // Displaying vector elements using begin() and end() 
-    for (ptr = matrixList.begin(); ptr < matrixList.end(); ptr++){
-        draw_matrix(*ptr, worldMatrixLocation);
-    }
+void mouseButtonCallback(GLFWwindow* window, int /*button*/, int /*action*/, int /*mods*/)
+{
+    static_cast< FramePacer* >(glfwGetWindowUserPointer(window))->input_received();
 }
 
-// draw the given list of list of matrix
-void draw_models(std::vector< std::vector< mat4 >> matrixLists, GLuint worldMatrixLocation){
-    // Declaring iterator to a vector 
-    std::vector<std::vector< mat4 >>::iterator ptr; 
-      
-    // Displaying vector elements using begin() and end() 
-    for (ptr = matrixLists.begin(); ptr < matrixLists.end(); ptr++){
-        draw_model(*ptr, worldMatrixLocation);
+void cursorPositionCallback(GLFWwindow* window, double /*x*/, double /*y*/)
+{
+    // the mouse only acts while dragging
+    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS || glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS ||
+        glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_MIDDLE) == GLFW_PRESS)
+    {
+        static_cast< FramePacer* >(glfwGetWindowUserPointer(window))->input_received();
     }
 }
 
-// ### TRANSFORM HELPER FUNCTIONS ###
+// render the initial view with the CPU rasterizer (no window, no GL context) and save it as a PPM image
+int runSoftwareRenderer(const std::string& outputPath, int numThreads, int numFrames, RenderMode renderMode, bool multiView, bool occlusionCulling, int animatedModels, bool showTelemetry)
+{
+    Scene scene;
+    build_scene(scene);
 
-// apply the transform to the given list of matrix
-std::vector< mat4 > apply_transform_2_model(std::vector< mat4 > matrixList, mat4 matrixTransform){
-    // Declaring iterator to a vector 
-    std::vector< mat4 >::iterator ptr; 
+    AnimationSystem animation;
+    animate_ring_models(animation, add_ring_models(scene, animatedModels), animatedModels);
+    update_scene(scene, 0.0f, 0.0f);
 
-    std::vector< mat4 > matrixListTransformed;
+    // same initial camera as the main loop
+    Camera camera(vec3(0.6f, 1.0f, 10.0f), 90.0f, 0.0f, 45.0f);
+    camera.set_framebuffer_size(1024, 768);
 
-    // Displaying vector elements using begin() and end() 
-    for (ptr = matrixList.begin(); ptr < matrixList.end(); ptr++){
-        mat4 matrixTransformed = matrixTransform * *ptr;
-        matrixListTransformed.push_back(matrixTransformed);
-    }
+    SoftwareRasterizer rasterizer(1024, 768, numThreads);
+    rasterizer.set_view_projection(camera.view_matrix(), camera.projection_matrix());
+    rasterizer.set_render_mode(renderMode);
 
-    return matrixListTransformed;
-}
-
-// apply the transform to the given list of list of matrix
-std::vector< std::vector< mat4 > > apply_transform_2_models(std::vector< std::vector< mat4 > > matrixLists, mat4 matrixTransform){
-    // Declaring iterator to a vector 
-    std::vector<std::vector< mat4 >>::iterator ptr; 
-
-    std::vector< std::vector< mat4 > > matrixListsTransformed;
+    MultiViewRenderer multiViewRenderer;
+    OcclusionCuller occlusionCuller;
+    for (int frame = 0; frame < numFrames; frame++)
+    {
+        // 60 frames per second of animation time
+        if (animation.channel_count() > 0)
+        {
+            animation.evaluate(frame / 60.0f, scene.list_letter_id);
+            update_scene(scene, 0.0f, 0.0f);
+        }
 
-    // Displaying vector elements using begin() and end() 
-    for (ptr = matrixLists.begin(); ptr < matrixLists.end(); ptr++){
-        std::vector<mat4> matrixListTransformed = apply_transform_2_model(*ptr, matrixTransform);
-        matrixListsTransformed.push_back(matrixListTransformed);
+        rasterizer.begin_frame();
+        if (occlusionCulling)
+        {
+            // the occluders are the visible models of the previous frame
+            occlusionCuller.cull_scene(scene, camera);
+            draw_scene(scene, rasterizer, &occlusionCuller.visible_models());
+        }
+        else if (multiView)
+        {
+            // one pass per view (the instanced single pass needs the GL backend)
+            multiViewRenderer.prepare(scene, monitor_views(scene, 0, camera.view_matrix(), camera.fov(), 1024, 768));
+            multiViewRenderer.render_multi_pass(rasterizer);
+        }
+        else
+        {
+            draw_scene(scene, rasterizer);
+        }
+        rasterizer.end_frame();
+        telemetry_end_frame();
     }
-
-    return matrixListsTransformed;
-}
-
-// ### MODEL DRAWING HELPER FUNCTIONS ###
-
-// draw a seven segment display (https://en.wikipedia.org/wiki/Seven-segment_display) -> given the list of which "character" to draw
-std::vector< mat4 > seven_seg_model(GLuint worldMatrixLocation, int segFlags[7]){
-
-    float width = 0.1f;
-    float depth = 0.1f;
-
-    float gridUnit = 0.2f;
-
-    float height = gridUnit * 3;
-
-    std::vector< mat4 > matrixList;
-    
-    // a
-    if(segFlags[0] == 1){
-        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(0.0f, height * 2 , 0.0f)) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)) * scale(mat4(1.0f), vec3(width, height, depth));
-        matrixList.push_back(pillarWorldMatrix);
+    rasterizer.print_stats();
+    if (multiView)
+    {
+        multiViewRenderer.print_stats();
     }
-
-    // b
-    if(segFlags[1] == 1){
-        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(height/2, height + (height/2), 0.0f))  * scale(mat4(1.0f), vec3(width, height, depth));
-        matrixList.push_back(pillarWorldMatrix);
+    if (occlusionCulling)
+    {
+        occlusionCuller.print_stats();
     }
-
-    // c
-    if(segFlags[2] == 1){
-        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(height/2, height/2, 0.0f))  * scale(mat4(1.0f), vec3(width, height, depth));
-        matrixList.push_back(pillarWorldMatrix);
+    if (animation.channel_count() > 0)
+    {
+        animation.print_stats();
     }
-
-    // d
-    if(segFlags[3] == 1){
-        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(0.0f, 0.0f, 0.0f)) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)) * scale(mat4(1.0f), vec3(width, height, depth));
-        matrixList.push_back(pillarWorldMatrix);
+    if (showTelemetry)
+    {
+        telemetry_print();
     }
 
-    // e
-    if(segFlags[4] == 1){
-        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(- height/2, height/2, 0.0f))  * scale(mat4(1.0f), vec3(width, height, depth));
-        matrixList.push_back(pillarWorldMatrix);
+    if (!rasterizer.write_ppm(outputPath))
+    {
+        std::cerr << "Failed to write " << outputPath << std::endl;
+        return -1;
     }
+    return 0;
+}
 
-    // f
-    if(segFlags[5] == 1){
-        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(- height/2, height + (height/2), 0.0f))  * scale(mat4(1.0f), vec3(width, height, depth));
-        matrixList.push_back(pillarWorldMatrix);
+int main(int argc, char*argv[])
+{
+    // Command line options
+    bool showStartupStats = false;
+    bool useShaderCache = true;
+    std::string shaderCachePath = "ass1_shader_cache.bin";
+    std::string softwareOutputPath;
+    int softwareThreads = 0;
+    int softwareFrames = 1;
+    RenderMode softwareRenderMode = RENDER_FILL;
+    bool multiView = false;
+    bool multiViewPasses = false;
+    bool occlusionCulling = false;
+    int animatedModels = 0;
+    PacingMode pacingMode = PACING_VSYNC;
+    double targetFps = 60.0;
+    bool showFrameStats = false;
+    bool showTelemetry = false;
+    int telemetryPort = 0;
+    std::string telemetrySocketPath;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--startup-stats") == 0)
+        {
+            showStartupStats = true;
+        }
+        else if (strcmp(argv[i], "--no-shader-cache") == 0)
+        {
+            useShaderCache = false;
+        }
+        else if (strcmp(argv[i], "--shader-cache") == 0 && i + 1 < argc)
+        {
+            shaderCachePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--software") == 0 && i + 1 < argc)
+        {
+            softwareOutputPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            softwareThreads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            softwareFrames = std::max(1, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--render-mode") == 0 && i + 1 < argc)
+        {
+            i++;
+            softwareRenderMode = (argv[i][0] == 'p') ? RENDER_POINTS : (argv[i][0] == 'l') ? RENDER_LINES : RENDER_FILL;
+        }
+        else if (strcmp(argv[i], "--multi-view") == 0)
+        {
+            multiView = true;
+        }
+        else if (strcmp(argv[i], "--multi-view-passes") == 0)
+        {
+            multiView = true;
+            multiViewPasses = true;
+        }
+        else if (strcmp(argv[i], "--occlusion-culling") == 0)
+        {
+            occlusionCulling = true;
+        }
+        else if (strcmp(argv[i], "--animate") == 0 && i + 1 < argc)
+        {
+            animatedModels = std::max(0, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--vsync") == 0)
+        {
+            pacingMode = PACING_VSYNC;
+        }
+        else if (strcmp(argv[i], "--uncapped") == 0)
+        {
+            pacingMode = PACING_UNCAPPED;
+        }
+        else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+        {
+            pacingMode = PACING_TARGET_FPS;
+            targetFps = std::max(1.0, atof(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--frame-stats") == 0)
+        {
+            showFrameStats = true;
+        }
+        else if (strcmp(argv[i], "--telemetry") == 0)
+        {
+            showTelemetry = true;
+        }
+        else if (strcmp(argv[i], "--telemetry-port") == 0 && i + 1 < argc)
+        {
+            telemetryPort = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--telemetry-socket") == 0 && i + 1 < argc)
+        {
+            telemetrySocketPath = argv[++i];
+        }
     }
 
-    // g
-    if(segFlags[6] == 1){
-        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(0.0f, height, 0.0f)) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)) * scale(mat4(1.0f), vec3(width, height, depth));
-        matrixList.push_back(pillarWorldMatrix);
+    if (!softwareOutputPath.empty())
+    {
+        return runSoftwareRenderer(softwareOutputPath, softwareThreads, softwareFrames, softwareRenderMode, multiView, occlusionCulling, animatedModels, showTelemetry);
     }
 
-    return matrixList;
-}
+    StartupStats startupStats;
 
+    // Resource telemetry for local scrapers (soak runs)
+    if (telemetryPort > 0 || !telemetrySocketPath.empty())
+    {
+        if (!telemetry_start_server(telemetryPort, telemetrySocketPath))
+        {
+            std::cerr << "Failed to start the telemetry endpoint" << std::endl;
+            telemetry_stop_server(); // the port or the socket that did start
+            return -1;
+        }
+    }
+
+    // Build the scene on a worker thread while the window and the context are created (CPU only, no GL calls)
+    Scene scene;
+    AnimationSystem animation;
+    double sceneBuildMs = 0.0;
+    std::thread sceneThread([&scene, &animation, animatedModels, &sceneBuildMs]() {
+        StartupStats sceneStats;
+        build_scene(scene);
+        animate_ring_models(animation, add_ring_models(scene, animatedModels), animatedModels);
+        sceneBuildMs = sceneStats.elapsed_ms();
+    });
 
-int main(int argc, char*argv[])
-{
     // Initialize GLFW and OpenGL version
     glfwInit();
+    startupStats.mark("glfw init");
     
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
@@ -418,50 +394,77 @@ int main(int argc, char*argv[])
     if (window == NULL)
     {
         std::cerr << "Failed to create GLFW window" << std::endl;
+        sceneThread.join();
+        telemetry_stop_server();
         glfwTerminate();
         return -1;
     }
     glfwMakeContextCurrent(window);
+    startupStats.mark("window + context");
+
+    // Frame pacing : vsync, uncapped or capped by the pacer
+    FramePacer framePacer(pacingMode, targetFps);
+    glfwSwapInterval(framePacer.swap_interval());
+
+    glfwSetWindowUserPointer(window, &framePacer);
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetCursorPosCallback(window, cursorPositionCallback);
     
     // Initialize GLEW
     glewExperimental = true; // Needed for core profile
     if (glewInit() != GLEW_OK) {
         std::cerr << "Failed to create GLEW" << std::endl;
+        sceneThread.join();
+        telemetry_stop_server();
         glfwTerminate();
         return -1;
     }
 
+    startupStats.mark("glew init");
+
     // Black background
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     
-    // Compile and link shaders here ...
-    int shaderProgram = compileAndLinkShaders();
+    // Load the shader program from the binary cache, compile and link shaders if it is missing or stale
+    uint64_t shaderCacheKey = program_cache_key(getVertexShaderSource(), getFragmentShaderSource());
+    int shaderProgram = useShaderCache ? load_program_binary(shaderCachePath, shaderCacheKey) : 0;
+    if (shaderProgram != 0)
+    {
+        startupStats.mark("shader program (cached)");
+    }
+    else
+    {
+        shaderProgram = compileAndLinkShaders();
+        if (useShaderCache)
+        {
+            save_program_binary(shaderProgram, shaderCachePath, shaderCacheKey);
+        }
+        startupStats.mark(program_binary_supported() ? "shader program (compiled)" : "shader program (no binary support)");
+    }
     
     // We can set the shader once, since we have only one
     glUseProgram(shaderProgram);
+
+    GLRenderBackend glBackend(shaderProgram);
     
-    // Camera parameters for view transform
-    vec3 cameraPosition(0.6f,1.0f,10.0f);
-    vec3 cameraLookAt(0.0f, 0.0f, -1.0f);
-    vec3 cameraUp(0.0f, 1.0f, 0.0f);
-    
+    // Camera (looking at -z, horizontal angle 90, fov 45)
+    Camera camera(vec3(0.6f, 1.0f, 10.0f), 90.0f, 0.0f, 45.0f);
+
     // Other camera parameters
-    float cameraSpeed = 5.0f;
-    float cameraFastSpeed = 5 * cameraSpeed;
-    float cameraHorizontalAngle = 90.0f;
-    float cameraVerticalAngle = 0.0f;
-    bool  cameraFirstPerson = true; // press 1 or 2 to toggle this variable
-
-    // Set initial view matrix
-    mat4 viewMatrix = lookAt(cameraPosition,  // eye
-                             cameraPosition + cameraLookAt,  // center
-                             cameraUp ); // up
+    float cameraPanSpeed = 0.02f; // world units per pixel of mouse movement
+    float cameraFastFactor = 5.0f;
+    float cameraFocusDistance = 8.0f;
+    int lastFocusKeyState = GLFW_RELEASE;
+
+    int framebufferWidth, framebufferHeight;
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    camera.set_framebuffer_size(framebufferWidth, framebufferHeight);
+    glBackend.set_viewport(0, 0, framebufferWidth, framebufferHeight);
+
+    glBackend.set_view_projection(camera.view_matrix(), camera.projection_matrix());
+    unsigned uploadedCameraRevision = camera.revision();
     
-    GLuint viewMatrixLocation = glGetUniformLocation(shaderProgram, "viewMatrix");
-    glUniformMatrix4fv(viewMatrixLocation, 1, GL_FALSE, &viewMatrix[0][0]);
-    
-    // For frame time
-    float lastFrameTime = glfwGetTime();
     int lastMouseLeftState = GLFW_RELEASE;
     double lastMousePosX, lastMousePosY;
     glfwGetCursorPos(window, &lastMousePosX, &lastMousePosY);
@@ -475,197 +478,140 @@ int main(int argc, char*argv[])
     glEnable(GL_DEPTH_TEST);
     
     // Input Parameters init.
-    float gridUnit = 0.2f;
-
-    int numLetterID = 5;
     int focusLetterID = 0;
     float scaleLetterID = 1.0f;
 
-    GLuint worldMatrixLocation = glGetUniformLocation(shaderProgram, "worldMatrix");
     float worldAngleX = 0.0f;
     float worldAngleY = 0.0f;
 
-    float fov = 45.0f;
-
-    int vbo;
-
-    vec3 dummyVect = vec3(0.0f, 0.0f, 1.0f);
-
-    // Init Letters
-    std::vector<mat4> matrixList;
-    std::vector<mat4> matrixListTransformed;
-    std::vector<std::vector< mat4 >> letter_id_matrix;
-    mat4 translateMatrix;
-    mat4 rotateMatrixInit;
-
-    int segP[] = {1,1,0,0,1,1,1};
-    matrixList = seven_seg_model(worldMatrixLocation, segP);
-    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * 5), (gridUnit * 0), (gridUnit * 0)));
-    matrixListTransformed = apply_transform_2_model(matrixList, translateMatrix);
-    letter_id_matrix.push_back(matrixListTransformed);
-
-    int segE[] = {1,0,0,1,1,1,1};
-    matrixList = seven_seg_model(worldMatrixLocation, segE);
-    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * 10), (gridUnit * 0), (gridUnit * 0)));
-    matrixListTransformed = apply_transform_2_model(matrixList, translateMatrix);
-    letter_id_matrix.push_back(matrixListTransformed);
-
-    // Init ID
-    int seg2[] = {1,1,0,1,1,0,1};
-    matrixList = seven_seg_model(worldMatrixLocation, seg2);
-    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * 17), (gridUnit * 0), (gridUnit * 0)));
-    matrixListTransformed = apply_transform_2_model(matrixList, translateMatrix);
-    letter_id_matrix.push_back(matrixListTransformed);
-
-    int seg8[] = {1,1,1,1,1,1,1};
-    matrixList = seven_seg_model(worldMatrixLocation, seg8);
-    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * 22), (gridUnit * 0), (gridUnit * 0)));
-    matrixListTransformed = apply_transform_2_model(matrixList, translateMatrix);
-    letter_id_matrix.push_back(matrixListTransformed);
-
-    // List of Letter/ID
-    std::vector< LetterIDModel > list_letter_id;
-    int circleDistance = 50;
-    int offsetDistance = 15; // to correct when we rotate the 3 and 6 o clock models, to be relatively centered with regard to x-axis
-
-    // 12 o clock letter/id
-    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * 0), (gridUnit * 0), (gridUnit * -circleDistance)));
-    std::vector<std::vector< mat4 >> new_letter_id_matrix = apply_transform_2_models(letter_id_matrix, translateMatrix);
-    LetterIDModel model = LetterIDModel(new_letter_id_matrix);
-    list_letter_id.push_back(model);
-
-    // 6 o clock letter/id
-    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * offsetDistance), (gridUnit * 0), (gridUnit * circleDistance)));
-    rotateMatrixInit = rotate(glm::mat4(1.0f), glm::radians(-180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-    new_letter_id_matrix = apply_transform_2_models(letter_id_matrix, translateMatrix * rotateMatrixInit);
-    model = LetterIDModel(new_letter_id_matrix);
-    list_letter_id.push_back(model);
-
-    // 3 o clock letter/id
-    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * circleDistance), (gridUnit * 0), (gridUnit * -offsetDistance)));
-    rotateMatrixInit = rotate(glm::mat4(1.0f), glm::radians(-90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-    new_letter_id_matrix = apply_transform_2_models(letter_id_matrix, translateMatrix * rotateMatrixInit);
-    model = LetterIDModel(new_letter_id_matrix);
-    list_letter_id.push_back(model);
-
-    // 9 o clock letter/id
-    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * -circleDistance), (gridUnit * 0), (gridUnit * offsetDistance)));
-    rotateMatrixInit = rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-    new_letter_id_matrix = apply_transform_2_models(letter_id_matrix, translateMatrix * rotateMatrixInit);
-    model = LetterIDModel(new_letter_id_matrix);
-    list_letter_id.push_back(model);
-
-    // middle letter/id
-    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * 0), (gridUnit * 0), (gridUnit * 0)));
-    new_letter_id_matrix = apply_transform_2_models(letter_id_matrix, translateMatrix);
-    model = LetterIDModel(new_letter_id_matrix);
-    list_letter_id.push_back(model);
+    // Wait for the scene and upload it
+    sceneThread.join();
+    startupStats.mark("wait for scene");
+    startupStats.add("scene build", sceneBuildMs);
+
+    scene.glyphCache.upload();
+    startupStats.mark("gpu upload");
+
+    std::vector< LetterIDModel >& list_letter_id = scene.list_letter_id;
+    bool firstFrame = true;
+
+    MultiViewRenderer multiViewRenderer;
+    OcclusionCuller occlusionCuller;
+    int statsFrame = 0;
+    float animationTime = 0.0f;
     
     // Entering Main Loop
     while(!glfwWindowShouldClose(window))
     {
-        // Frame time calculation
-        float dt = glfwGetTime() - lastFrameTime;
-        lastFrameTime += dt;
+        // Frame time calculation (steady clock)
+        float dt = framePacer.begin_frame();
+        bool printStats = (++statsFrame % 300 == 0);
 
         // Each frame, reset color of each pixel to glClearColor
-
-        // @TODO 1 - Clear Depth Buffer Bit as well
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        //glClear(GL_COLOR_BUFFER_BIT);
+        glBackend.begin_frame();
         
-        // Make Grid
-        int gridSize = 128;
-        std::vector<mat4> og_gridMatrixList;
-        for (int i=0; i<(gridSize/2); ++i)
+        // ### Animation ###
+        if (animation.channel_count() > 0)
         {
-            mat4 zAxisLineMatrix = translate(mat4(1.0f), vec3(0.0f + (i * gridUnit), 0.0f, 0.0f)) * scale(mat4(1.0f), vec3(0.01f, 0.01f, gridUnit * gridSize));
+            animationTime += dt;
+            animation.evaluate(animationTime, list_letter_id);
 
-            // turn 90
-            mat4 xAxisLineMatrix = translate(mat4(1.0f), vec3(0.0f, 0.0f, 0.0f + (i * gridUnit))) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)) * scale(mat4(1.0f), vec3(0.01f, 0.01f, gridUnit * gridSize));
-            
-            og_gridMatrixList.push_back(zAxisLineMatrix);
-            og_gridMatrixList.push_back(xAxisLineMatrix);
-        }
-
-        for (int i=0; i<(gridSize/2); ++i)
-        {
-            mat4 zAxisLineMatrix = translate(mat4(1.0f), vec3(0.0f + (-i * gridUnit), 0.0f, 0.0f)) * scale(mat4(1.0f), vec3(0.01f, 0.01f, gridUnit * gridSize));
-
-            // turn 90
-            mat4 xAxisLineMatrix = translate(mat4(1.0f), vec3(0.0f, 0.0f, 0.0f + (-i * gridUnit))) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)) * scale(mat4(1.0f), vec3(0.01f, 0.01f, gridUnit * gridSize));
-        
-            og_gridMatrixList.push_back(zAxisLineMatrix);
-            og_gridMatrixList.push_back(xAxisLineMatrix);
+            if (printStats)
+            {
+                animation.print_stats();
+            }
         }
-        
-        // Make Axis
-        float lengthAxis = gridUnit * 7;
-
-        mat4 og_yAxisMatrix = translate(mat4(1.0f), vec3(0.0f , lengthAxis/2, 0.0f)) * scale(mat4(1.0f), vec3(0.05f, lengthAxis, 0.05f));
-        mat4 og_xAxisMatrix = translate(mat4(1.0f), vec3(lengthAxis/2 , 0.0f, 0.0f)) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)) * scale(mat4(1.0f), vec3(0.05f, lengthAxis, 0.05f));
-        mat4 og_zAxisMatrix = translate(mat4(1.0f), vec3(0.0f , 0.0f, lengthAxis/2)) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f)) * scale(mat4(1.0f), vec3(0.05f, lengthAxis, 0.05f));
 
         // ### Apply Input Transformations ###
+        update_scene(scene, worldAngleX, worldAngleY);
 
-        // world Rotations
-        mat4 worldXRotateMatrix = rotate(glm::mat4(1.0f), glm::radians(worldAngleX), glm::vec3(1.0f, 0.0f, 0.0f));
-        mat4 worldYRotateMatrix = rotate(glm::mat4(1.0f), glm::radians(worldAngleY), glm::vec3(0.0f, 1.0f, 0.0f));
-        mat4 worldRotateMatrix = worldXRotateMatrix * worldYRotateMatrix;
-        
-        // grid rotations
-        std::vector< mat4 > gridMatrixList = apply_transform_2_model(og_gridMatrixList, worldRotateMatrix);
-
-        // axis rotations
-        mat4 yAxisMatrix = worldRotateMatrix * og_yAxisMatrix;
-        mat4 xAxisMatrix = worldRotateMatrix * og_xAxisMatrix;
-        mat4 zAxisMatrix = worldRotateMatrix * og_zAxisMatrix;
+        // ### Camera ###
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        if (camera.set_framebuffer_size(framebufferWidth, framebufferHeight))
+        {
+            glBackend.set_viewport(0, 0, framebufferWidth, framebufferHeight);
+        }
 
-        // model letter/id rotations & specific transformations for focused model
-        for(int i = 0; i < numLetterID; i++){
-            mat4 scaleMatrix = scale(mat4(1.0f), vec3(list_letter_id[i].scale, list_letter_id[i].scale, list_letter_id[i].scale));
-            mat4 moveMatrix = translate(mat4(1.0f), vec3(list_letter_id[i].x,list_letter_id[i].y,list_letter_id[i].z));
-            mat4 rotateMatrix = rotate(glm::mat4(1.0f), glm::radians(list_letter_id[i].angle), glm::vec3(0.0f, 1.0f, 0.0f));
+        if (camera.focused())
+        {
+            camera.set_focus_target(letter_id_center(list_letter_id[focusLetterID]));
+        }
+        camera.update(dt);
 
-            list_letter_id[i].m_letter_id_matrix = apply_transform_2_models(list_letter_id[i].og_letter_id_matrix, worldRotateMatrix * moveMatrix * scaleMatrix * rotateMatrix );
+        // matrices are only rebuilt and uploaded when the camera changed
+        if (camera.revision() != uploadedCameraRevision)
+        {
+            glBackend.set_view_projection(camera.view_matrix(), camera.projection_matrix());
+            uploadedCameraRevision = camera.revision();
         }
 
         // ### DRAWING ###
-        
-        // Draw Grid
-        vec3 whiteVect = vec3(1.0f, 1.0f, 1.0f);
-        int w_vbo = createVertexBufferObject(false, whiteVect);
-        glBindBuffer(GL_ARRAY_BUFFER, w_vbo); // FIXME -> not sure if this is good
-        draw_model(gridMatrixList, worldMatrixLocation);
-        
-        // Draw Axis
-        vec3 greenVect = vec3(0.0f, 1.0f, 0.0f);
-        vbo = createVertexBufferObject(false, greenVect);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo); // FIXME -> not sure if this is good
-
-        draw_matrix(yAxisMatrix, worldMatrixLocation);
-
-        vec3 redVect = vec3(1.0f, 0.0f, 0.0f);
-        vbo = createVertexBufferObject(false, redVect);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo); // FIXME -> not sure if this is good
+        if (multiView)
+        {
+            multiViewRenderer.prepare(scene, monitor_views(scene, focusLetterID, camera.view_matrix(), camera.fov(), framebufferWidth, framebufferHeight));
+            if (multiViewPasses)
+            {
+                multiViewRenderer.render_multi_pass(glBackend);
+            }
+            else
+            {
+                multiViewRenderer.render_single_pass(glBackend, framebufferWidth, framebufferHeight);
+            }
 
-        draw_matrix(xAxisMatrix, worldMatrixLocation);
+            // back to the whole window for the next frame
+            glBackend.set_viewport(0, 0, framebufferWidth, framebufferHeight);
+            glBackend.set_view_projection(camera.view_matrix(), camera.projection_matrix());
 
-        vec3 blueVect = vec3(0.0f, 0.0f, 1.0f);
-        vbo = createVertexBufferObject(false, blueVect);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo); // FIXME -> not sure if this is good
+            if (printStats)
+            {
+                multiViewRenderer.print_stats();
+            }
+        }
+        else if (occlusionCulling)
+        {
+            occlusionCuller.cull_scene(scene, camera);
+            draw_scene(scene, glBackend, &occlusionCuller.visible_models());
 
-        draw_matrix(zAxisMatrix, worldMatrixLocation);
-        
-        //// Draw the Letter/ID list
-        vbo = createVertexBufferObject(true, dummyVect);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo); // FIXME -> not sure if this is good
-        for(int i = 0; i < numLetterID; i++){
-            draw_models(list_letter_id[i].m_letter_id_matrix, worldMatrixLocation);
+            if (printStats)
+            {
+                occlusionCuller.print_stats();
+            }
+        }
+        else
+        {
+            draw_scene(scene, glBackend);
         }
+        glBackend.end_frame();
         
         // ### End Frame ###
         glfwSwapBuffers(window);
+        framePacer.frame_swapped();
+        telemetry_end_frame();
+
+        // before the pacer wait : the frame cap is not part of the startup time
+        if (firstFrame)
+        {
+            startupStats.mark("first frame");
+            if (showStartupStats)
+            {
+                startupStats.print();
+            }
+            firstFrame = false;
+        }
+
+        if (showTelemetry && printStats)
+        {
+            telemetry_print();
+        }
+
+        if (showFrameStats && printStats)
+        {
+            framePacer.print_stats();
+            framePacer.reset_stats();
+        }
+
+        // wait before polling : the inputs are read as late as possible
+        framePacer.wait_for_next_frame();
         glfwPollEvents();
         
         // ### Handle inputs ###
@@ -696,6 +642,21 @@ int main(int argc, char*argv[])
             focusLetterID = 4;
         }
 
+        // Orbit the selected model (toggle)
+        int focusKeyState = glfwGetKey(window, GLFW_KEY_F);
+        if (focusKeyState == GLFW_PRESS && lastFocusKeyState == GLFW_RELEASE)
+        {
+            if (camera.focused())
+            {
+                camera.unfocus();
+            }
+            else
+            {
+                camera.focus(letter_id_center(list_letter_id[focusLetterID]), cameraFocusDistance);
+            }
+        }
+        lastFocusKeyState = focusKeyState;
+
         // Scaling
         if (glfwGetKey(window, GLFW_KEY_U) == GLFW_PRESS) // scale up
         {
@@ -804,17 +765,17 @@ int main(int argc, char*argv[])
         // Render modes
         if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS) // point render mode
         {
-            glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
+            glBackend.set_render_mode(RENDER_POINTS);
         }
 
         if (glfwGetKey(window, GLFW_KEY_L) == GLFW_PRESS) // line render mode
         {
-            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+            glBackend.set_render_mode(RENDER_LINES);
         }
 
         if (glfwGetKey(window, GLFW_KEY_T) == GLFW_PRESS) // triangle render mode
         {
-            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+            glBackend.set_render_mode(RENDER_FILL);
         }
 
         // Camera Input
@@ -830,25 +791,12 @@ int main(int argc, char*argv[])
         lastMousePosY = mousePosY;
 
         bool fastCam = glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS;
-        float currentCameraSpeed = (fastCam) ? cameraFastSpeed : cameraSpeed;
+        float currentPanSpeed = (fastCam) ? cameraFastFactor * cameraPanSpeed : cameraPanSpeed;
 
-        // Pan Camera
-        int panSensitivity = 5; // reduce the sensibility of the panning to mouse movements
+        // Pan Camera (follows the mouse movement, on the xz plane)
         if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS)
         {
-            if(dx < -panSensitivity){
-                cameraPosition.x += currentCameraSpeed * dt;
-            }
-            else if (dx > panSensitivity ){
-                cameraPosition.x -= currentCameraSpeed * dt;
-            }
-
-            if(dy < -panSensitivity ){
-                cameraPosition.z += currentCameraSpeed * dt;
-            }
-            else if (dy > panSensitivity ){
-                cameraPosition.z -= currentCameraSpeed * dt;
-            }
+            camera.move(vec3(-dx * currentPanSpeed, 0.0f, -dy * currentPanSpeed));
         }
 
         // Zoom Camera
@@ -856,65 +804,26 @@ int main(int argc, char*argv[])
         if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
         {
             if(dy < -zoomSensitivity){
-                fov += 1;
+                camera.zoom(1.0f);
             }
             else if (dy > zoomSensitivity){
-                fov -= 1;
-            }
-
-            // Correct angle if needed
-            if (fov < 1.0f){
-                fov = 1.0f;
-            }
-            if (fov > 45.0f){
-                fov = 45.0f; 
+                camera.zoom(-1.0f);
             }
         }
        
         // Convert to spherical coordinates
         const float cameraAngularSpeed = 40.0f;
 
-        // Tilt Camera
+        // Tilt Camera (orbits the selected model in focus mode)
         if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_MIDDLE) == GLFW_PRESS){
-            cameraHorizontalAngle -= dx * cameraAngularSpeed * dt;
-            cameraVerticalAngle   -= dy * cameraAngularSpeed * dt;
-        }
-        
-        // Clamp vertical angle to [-85, 85] degrees
-        cameraVerticalAngle = std::max(-85.0f, std::min(85.0f, cameraVerticalAngle));
-        if (cameraHorizontalAngle > 360)
-        {
-            cameraHorizontalAngle -= 360;
-        }
-        else if (cameraHorizontalAngle < -360)
-        {
-            cameraHorizontalAngle += 360;
+            camera.rotate(-dx * cameraAngularSpeed * dt, -dy * cameraAngularSpeed * dt);
         }
-        
-        float theta = radians(cameraHorizontalAngle);
-        float phi = radians(cameraVerticalAngle);
-        
-        cameraLookAt = vec3(cosf(phi)*cosf(theta), sinf(phi), -cosf(phi)*sinf(theta));
-        vec3 cameraSideVector = glm::cross(cameraLookAt, vec3(0.0f, 1.0f, 0.0f));
-        
-        glm::normalize(cameraSideVector);
-      
-        // Camera Matrix
-        // Set view matrix for shader
-        mat4 viewMatrix = lookAt(cameraPosition, cameraPosition + cameraLookAt, cameraUp );
-
-        GLuint viewMatrixLocation = glGetUniformLocation(shaderProgram, "viewMatrix");
-        glUniformMatrix4fv(viewMatrixLocation, 1, GL_FALSE, &viewMatrix[0][0]);
-
-        // Set projection matrix for shader
-        mat4 projectionMatrix = glm::perspective(glm::radians(fov),            // field of view in degrees
-                                                 800.0f / 600.0f,  // aspect ratio
-                                                 0.01f, 100.0f);   // near and far (near > 0)
-        
-        GLuint projectionMatrixLocation = glGetUniformLocation(shaderProgram, "projectionMatrix");
-        glUniformMatrix4fv(projectionMatrixLocation, 1, GL_FALSE, &projectionMatrix[0][0]);
     }
     
+    glBackend.release();
+    scene.glyphCache.release();
+    telemetry_stop_server();
+
     // Shutdown GLFW
     glfwTerminate();
     
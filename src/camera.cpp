@@ -0,0 +1,200 @@
+#include "camera.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace glm;
+
+// critically damped spring towards the goal (no overshoot), stable for any dt
+// (Game Programming Gems 4, 1.10 "Critically Damped Ease-In/Ease-Out Smoothing")
+static vec3 smooth_damp(const vec3& current, const vec3& goal, vec3& velocity, float smoothTime, float dt){
+    float omega = 2.0f / smoothTime;
+    float x = omega * dt;
+    float decay = 1.0f / (1.0f + x + 0.48f * x * x + 0.235f * x * x * x);
+
+    vec3 change = current - goal;
+    vec3 temp = (velocity + omega * change) * dt;
+    velocity = (velocity - omega * temp) * decay;
+    return goal + (change + temp) * decay;
+}
+
+Camera::Camera(vec3 position, float horizontalAngle, float verticalAngle, float fov)
+    : m_position(position), m_horizontalAngle(horizontalAngle), m_verticalAngle(verticalAngle), m_fov(fov)
+{
+    m_eye = m_position;
+    m_target = m_position + look_direction();
+}
+
+// ### INPUTS ###
+
+void Camera::move(const vec3& offset){
+    if(m_focused || offset == vec3(0.0f)){
+        return;
+    }
+    m_position += offset;
+    view_changed();
+}
+
+void Camera::rotate(float horizontalDelta, float verticalDelta){
+    if(horizontalDelta == 0.0f && verticalDelta == 0.0f){
+        return;
+    }
+
+    m_horizontalAngle += horizontalDelta;
+    m_verticalAngle = std::max(-85.0f, std::min(85.0f, m_verticalAngle + verticalDelta));
+
+    if(m_horizontalAngle > 360.0f){
+        m_horizontalAngle -= 360.0f;
+    }
+    else if(m_horizontalAngle < -360.0f){
+        m_horizontalAngle += 360.0f;
+    }
+
+    view_changed();
+}
+
+void Camera::zoom(float fovDelta){
+    float fov = std::max(1.0f, std::min(45.0f, m_fov + fovDelta));
+    if(fov != m_fov){
+        m_fov = fov;
+        projection_changed();
+    }
+}
+
+bool Camera::set_framebuffer_size(int width, int height){
+    // minimized window -> keep the last size
+    if(width <= 0 || height <= 0 || (width == m_framebufferWidth && height == m_framebufferHeight)){
+        return false;
+    }
+    m_framebufferWidth = width;
+    m_framebufferHeight = height;
+    projection_changed();
+    return true;
+}
+
+// ### ORBIT MODE ###
+
+void Camera::focus(const vec3& target, float distance){
+    m_focused = true;
+    m_focusTarget = target;
+    m_focusDistance = distance;
+    m_eyeVelocity = vec3(0.0f);
+    m_targetVelocity = vec3(0.0f);
+}
+
+void Camera::set_focus_target(const vec3& target){
+    m_focusTarget = target;
+}
+
+void Camera::unfocus(){
+    if(!m_focused){
+        return;
+    }
+    m_focused = false;
+
+    // keep looking from the same place in the same direction
+    vec3 direction = normalize(m_target - m_eye);
+    m_position = m_eye;
+    m_verticalAngle = degrees(asinf(std::max(-1.0f, std::min(1.0f, direction.y))));
+    m_horizontalAngle = degrees(atan2f(-direction.z, direction.x));
+    view_changed();
+}
+
+void Camera::update(float dt){
+    if(!m_focused || dt <= 0.0f){
+        return;
+    }
+
+    vec3 goalEye = goal_eye();
+    if(m_eye == goalEye && m_target == m_focusTarget){
+        return;
+    }
+
+    m_eye = smooth_damp(m_eye, goalEye, m_eyeVelocity, m_smoothTime, dt);
+    m_target = smooth_damp(m_target, m_focusTarget, m_targetVelocity, m_smoothTime, dt);
+
+    // settled -> stop rebuilding the view every frame
+    const float epsilon = 1e-4f;
+    if(length(m_eye - goalEye) < epsilon && length(m_target - m_focusTarget) < epsilon){
+        m_eye = goalEye;
+        m_target = m_focusTarget;
+        m_eyeVelocity = vec3(0.0f);
+        m_targetVelocity = vec3(0.0f);
+    }
+
+    m_viewDirty = true;
+    m_viewProjectionDirty = true;
+    m_frustumDirty = true;
+    m_revision++;
+}
+
+// ### OUTPUTS ###
+
+vec3 Camera::look_direction() const{
+    float theta = radians(m_horizontalAngle);
+    float phi = radians(m_verticalAngle);
+    return vec3(cosf(phi) * cosf(theta), sinf(phi), -cosf(phi) * sinf(theta));
+}
+
+float Camera::aspect_ratio() const{
+    return (float)m_framebufferWidth / m_framebufferHeight;
+}
+
+const mat4& Camera::view_matrix() const{
+    if(m_viewDirty){
+        m_viewMatrix = lookAt(m_eye, m_target, vec3(0.0f, 1.0f, 0.0f));
+        m_viewDirty = false;
+    }
+    return m_viewMatrix;
+}
+
+const mat4& Camera::projection_matrix() const{
+    if(m_projectionDirty){
+        m_projectionMatrix = perspective(radians(m_fov), aspect_ratio(), m_near, m_far);
+        m_projectionDirty = false;
+    }
+    return m_projectionMatrix;
+}
+
+const mat4& Camera::view_projection() const{
+    if(m_viewProjectionDirty){
+        m_viewProjection = projection_matrix() * view_matrix();
+        m_viewProjectionDirty = false;
+    }
+    return m_viewProjection;
+}
+
+const Frustum& Camera::frustum() const{
+    if(m_frustumDirty){
+        m_frustum = frustum_from_matrix(view_projection());
+        m_frustumDirty = false;
+    }
+    return m_frustum;
+}
+
+// ### CACHE ###
+
+vec3 Camera::goal_eye() const{
+    return m_focusTarget - look_direction() * m_focusDistance;
+}
+
+void Camera::view_changed(){
+    // the orbit position is reached by update()
+    if(!m_focused){
+        m_eye = m_position;
+        m_target = m_position + look_direction();
+    }
+    m_viewDirty = true;
+    m_viewProjectionDirty = true;
+    m_frustumDirty = true;
+    m_revision++;
+}
+
+void Camera::projection_changed(){
+    m_projectionDirty = true;
+    m_viewProjectionDirty = true;
+    m_frustumDirty = true;
+    m_revision++;
+}
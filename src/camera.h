@@ -0,0 +1,93 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "frustum.h"
+
+// Free look camera (position + horizontal / vertical angles) with an orbit mode around a focus point.
+// View, projection, view-projection and frustum are cached and only rebuilt when an input changed.
+class Camera {
+public:
+    Camera(glm::vec3 position, float horizontalAngle, float verticalAngle, float fov);
+
+    // ### INPUTS ###
+    void move(const glm::vec3& offset);
+
+    // degrees, the vertical angle is clamped to [-85, 85]
+    void rotate(float horizontalDelta, float verticalDelta);
+
+    // field of view in degrees, clamped to [1, 45]
+    void zoom(float fovDelta);
+
+    // returns true if the size changed (the caller updates the viewport)
+    bool set_framebuffer_size(int width, int height);
+
+    // ### ORBIT MODE ###
+    // orbit around the target at the given distance (the angles orbit instead of looking around)
+    void focus(const glm::vec3& target, float distance);
+
+    // follow a moving target while focused
+    void set_focus_target(const glm::vec3& target);
+
+    // back to the free camera, from where the orbit left it
+    void unfocus();
+
+    bool focused() const { return m_focused; }
+
+    // critically damped smoothing towards the orbit position (call once per frame)
+    void update(float dt);
+
+    // ### OUTPUTS ###
+    glm::vec3 position() const { return m_eye; }
+    glm::vec3 look_direction() const;
+    float fov() const { return m_fov; }
+
+    const glm::mat4& view_matrix() const;
+    const glm::mat4& projection_matrix() const;
+    const glm::mat4& view_projection() const;
+    const Frustum& frustum() const;
+
+    // incremented every time the matrices change (upload the uniforms only when it moved)
+    unsigned revision() const { return m_revision; }
+
+private:
+    void view_changed();
+    void projection_changed();
+    float aspect_ratio() const;
+
+    // where the camera wants to be (free camera : right away, orbit : after smoothing)
+    glm::vec3 goal_eye() const;
+
+    glm::vec3 m_position;
+    float m_horizontalAngle;
+    float m_verticalAngle;
+    float m_fov;
+    int m_framebufferWidth = 1024;
+    int m_framebufferHeight = 768;
+    float m_near = 0.01f;
+    float m_far = 100.0f;
+
+    // orbit mode
+    bool m_focused = false;
+    glm::vec3 m_focusTarget = glm::vec3(0.0f);
+    float m_focusDistance = 10.0f;
+    float m_smoothTime = 0.25f; // seconds to (almost) reach the goal
+    glm::vec3 m_targetVelocity = glm::vec3(0.0f);
+    glm::vec3 m_eyeVelocity = glm::vec3(0.0f);
+
+    // what is actually looked from / at
+    glm::vec3 m_eye;
+    glm::vec3 m_target;
+
+    unsigned m_revision = 0;
+
+    // cache
+    mutable bool m_viewDirty = true;
+    mutable bool m_projectionDirty = true;
+    mutable bool m_viewProjectionDirty = true;
+    mutable bool m_frustumDirty = true;
+    mutable glm::mat4 m_viewMatrix;
+    mutable glm::mat4 m_projectionMatrix;
+    mutable glm::mat4 m_viewProjection;
+    mutable Frustum m_frustum;
+};
@@ -0,0 +1,182 @@
+#include "frame_pacing.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+static const double bucketMs = 0.25;
+static const int bucketCount = 400; // up to 100 ms
+
+// ### HISTOGRAM ###
+
+LatencyHistogram::LatencyHistogram() : m_buckets(bucketCount + 1, 0) {}
+
+void LatencyHistogram::add(double ms){
+    int bucket = std::min(bucketCount, std::max(0, (int)(ms / bucketMs)));
+    m_buckets[bucket]++;
+    m_count++;
+    m_sumMs += ms;
+    m_maxMs = std::max(m_maxMs, ms);
+}
+
+void LatencyHistogram::reset(){
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_sumMs = 0.0;
+    m_maxMs = 0.0;
+}
+
+double LatencyHistogram::percentile_ms(double fraction) const{
+    long long target = (long long)(fraction * m_count + 0.5);
+    long long seen = 0;
+    for(int i = 0; i < bucketCount; i++){
+        seen += m_buckets[i];
+        if(seen >= target && seen > 0){
+            return std::min((i + 1) * bucketMs, m_maxMs);
+        }
+    }
+    return m_maxMs;
+}
+
+void LatencyHistogram::print(const char* name) const{
+    static const double edges[] = { 0.0, 1.0, 2.0, 4.0, 8.0, 12.0, 16.0, 20.0, 25.0, 33.0, 50.0, 100.0 };
+    const int rangeCount = sizeof(edges) / sizeof(edges[0]);
+
+    std::printf("  %-12s : %lld samples, mean %.2f ms, p50 %.2f, p95 %.2f, p99 %.2f, max %.2f ms\n", name, m_count,
+                mean_ms(), percentile_ms(0.5), percentile_ms(0.95), percentile_ms(0.99), m_maxMs);
+    if(m_count == 0){
+        return;
+    }
+
+    for(int r = 0; r < rangeCount; r++){
+        int firstBucket = (int)(edges[r] / bucketMs);
+        int lastBucket = (r + 1 < rangeCount) ? (int)(edges[r + 1] / bucketMs) : bucketCount + 1;
+
+        long long count = 0;
+        for(int i = firstBucket; i < lastBucket; i++){
+            count += m_buckets[i];
+        }
+        if(count == 0){
+            continue;
+        }
+
+        char range[32];
+        if(r + 1 < rangeCount){
+            std::snprintf(range, sizeof(range), "%g-%g ms", edges[r], edges[r + 1]);
+        }
+        else{
+            std::snprintf(range, sizeof(range), "%g+ ms", edges[r]);
+        }
+
+        int bar = (int)(40 * count / m_count);
+        std::printf("    %-10s %6.2f%% %s\n", range, 100.0 * count / m_count, std::string(std::max(1, bar), '#').c_str());
+    }
+}
+
+// ### PACER ###
+
+FramePacer::FramePacer(PacingMode mode, double targetFps){
+    set_mode(mode, targetFps);
+}
+
+void FramePacer::set_mode(PacingMode mode, double targetFps){
+    m_mode = mode;
+    m_period = std::chrono::duration_cast< Clock::duration >(std::chrono::duration< double >(1.0 / std::max(1.0, targetFps)));
+    m_deadline = Clock::time_point();
+}
+
+double FramePacer::seconds(Clock::duration duration){
+    return std::chrono::duration< double >(duration).count();
+}
+
+float FramePacer::begin_frame(){
+    Clock::time_point now = Clock::now();
+    if(!m_started){
+        m_started = true;
+        m_lastFrameStart = now;
+        return 0.0f;
+    }
+
+    double dt = seconds(now - m_lastFrameStart);
+    m_lastFrameStart = now;
+    m_frameTimes.add(dt * 1000.0);
+
+    return (float)std::min(dt, maxFrameTime);
+}
+
+void FramePacer::input_received(){
+    // the oldest one : the others are shown by the same swap
+    if(!m_inputPending){
+        m_inputPending = true;
+        m_inputTime = Clock::now();
+    }
+}
+
+void FramePacer::frame_swapped(){
+    if(m_inputPending){
+        m_latencies.add(seconds(Clock::now() - m_inputTime) * 1000.0);
+        m_inputPending = false;
+    }
+}
+
+void FramePacer::wait_for_next_frame(){
+    if(m_mode != PACING_TARGET_FPS){
+        return;
+    }
+
+    Clock::time_point now = Clock::now();
+    if(m_deadline == Clock::time_point()){
+        m_deadline = now;
+    }
+    m_deadline += m_period;
+
+    // too late : start again from now instead of rushing the next frames to catch up
+    if(m_deadline <= now){
+        m_missedDeadlines++;
+        m_deadline = now;
+        return;
+    }
+
+    // sleep is cheap but coarse : wake up a bit early ...
+    double sleepTime = seconds(m_deadline - now) - m_sleepOvershoot - minSleepMargin;
+    if(sleepTime > 0.0){
+        Clock::time_point sleepStart = Clock::now();
+        std::this_thread::sleep_for(std::chrono::duration< double >(sleepTime));
+        double slept = seconds(Clock::now() - sleepStart);
+
+        m_sleepOvershoot = 0.9 * m_sleepOvershoot + 0.1 * std::max(0.0, slept - sleepTime);
+        m_sleepMs += slept * 1000.0;
+    }
+
+    // ... and spin the rest, giving the core away between checks
+    Clock::time_point spinStart = Clock::now();
+    while(Clock::now() < m_deadline){
+        std::this_thread::yield();
+    }
+    m_spinMs += seconds(Clock::now() - spinStart) * 1000.0;
+}
+
+void FramePacer::reset_stats(){
+    m_frameTimes.reset();
+    m_latencies.reset();
+    m_sleepMs = 0.0;
+    m_spinMs = 0.0;
+    m_missedDeadlines = 0;
+}
+
+void FramePacer::print_stats() const{
+    if(m_mode == PACING_TARGET_FPS){
+        std::printf("### Frame pacing (target %.1f fps) ###\n", 1.0 / seconds(m_period));
+    }
+    else{
+        std::printf("### Frame pacing (%s) ###\n", (m_mode == PACING_VSYNC) ? "vsync" : "uncapped");
+    }
+
+    m_frameTimes.print("frame time");
+    if(m_mode == PACING_TARGET_FPS && m_frameTimes.count() > 0){
+        std::printf("  wait         : %.3f ms sleep + %.3f ms spin per frame, sleep overshoot %.3f ms, %d missed deadlines\n",
+                    m_sleepMs / m_frameTimes.count(), m_spinMs / m_frameTimes.count(), m_sleepOvershoot * 1000.0, m_missedDeadlines);
+    }
+    m_latencies.print("input->swap");
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+enum PacingMode {
+    PACING_VSYNC,     // swap interval 1, the driver waits for the vertical blank
+    PACING_UNCAPPED,  // swap interval 0, as fast as possible
+    PACING_TARGET_FPS // swap interval 0, the pacer waits until the next frame deadline
+};
+
+// Histogram of durations in milliseconds (0.25 ms buckets up to 100 ms, then one overflow bucket)
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void add(double ms);
+    void reset();
+
+    long long count() const { return m_count; }
+    double mean_ms() const { return (m_count > 0) ? m_sumMs / m_count : 0.0; }
+    double max_ms() const { return m_maxMs; }
+
+    // upper edge of the bucket containing the given fraction of the samples (0.5 = median)
+    double percentile_ms(double fraction) const;
+
+    // one line per non empty range (0-1, 1-2, 2-4 ... ms) with a bar
+    void print(const char* name) const;
+
+private:
+    std::vector< long long > m_buckets;
+    long long m_count = 0;
+    double m_sumMs = 0.0;
+    double m_maxMs = 0.0;
+};
+
+// Frame timing of the main loop : frame time from a steady clock (double precision), frame caps
+// (sleep most of the wait, then spin the last part for precision) and the latency between an input
+// event and the swap of the first frame that reflects it.
+//
+// Per frame :
+//   dt = begin_frame()      (top of the loop)
+//   ... update, draw ...
+//   glfwSwapBuffers(); frame_swapped(); wait_for_next_frame(); glfwPollEvents()
+// and input_received() from the input callbacks (called during glfwPollEvents()).
+class FramePacer {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    FramePacer(PacingMode mode = PACING_VSYNC, double targetFps = 60.0);
+
+    void set_mode(PacingMode mode, double targetFps);
+    PacingMode mode() const { return m_mode; }
+
+    // for glfwSwapInterval()
+    int swap_interval() const { return (m_mode == PACING_VSYNC) ? 1 : 0; }
+
+    // seconds since the previous begin_frame() (0 the first time, at most maxFrameTime)
+    float begin_frame();
+
+    // an input arrived (from glfwPollEvents(), GLFW has no event timestamps) :
+    // its latency is measured until the next swap, the one of the frame that handled it
+    void input_received();
+
+    // right after glfwSwapBuffers()
+    void frame_swapped();
+
+    // target fps mode : sleep, then spin until the frame deadline (no effect in the other modes)
+    void wait_for_next_frame();
+
+    void reset_stats();
+    void print_stats() const;
+
+    double maxFrameTime = 0.25;    // seconds, clamps dt after a stall (window dragged, debugger)
+    double minSleepMargin = 0.5e-3; // seconds always left to the spin, on top of the measured sleep overshoot
+
+private:
+    static double seconds(Clock::duration duration);
+
+    PacingMode m_mode;
+    Clock::duration m_period;
+
+    bool m_started = false;
+    Clock::time_point m_lastFrameStart;
+    Clock::time_point m_deadline;
+
+    // oldest input not on screen yet (polled -> handled -> drawn -> swapped)
+    bool m_inputPending = false;
+    Clock::time_point m_inputTime;
+
+    // how much later than asked sleep_for() returns (moving average, seconds)
+    double m_sleepOvershoot = 1.0e-3;
+
+    // stats
+    LatencyHistogram m_frameTimes;
+    LatencyHistogram m_latencies;
+    double m_sleepMs = 0.0;
+    double m_spinMs = 0.0;
+    int m_missedDeadlines = 0;
+};
@@ -0,0 +1,60 @@
+#include "frustum.h"
+
+#include <cmath>
+
+using namespace glm;
+
+Frustum frustum_from_matrix(const mat4& viewProjection){
+    // rows of the (column major) matrix
+    vec4 row[4];
+    for(int i = 0; i < 4; i++){
+        row[i] = vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    }
+
+    Frustum frustum;
+    frustum.planes[0] = row[3] + row[0];
+    frustum.planes[1] = row[3] - row[0];
+    frustum.planes[2] = row[3] + row[1];
+    frustum.planes[3] = row[3] - row[1];
+    frustum.planes[4] = row[3] + row[2];
+    frustum.planes[5] = row[3] - row[2];
+
+    for(int i = 0; i < 6; i++){
+        vec4& plane = frustum.planes[i];
+        float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        plane = plane * (1.0f / length);
+    }
+
+    return frustum;
+}
+
+bool frustum_intersects_aabb(const Frustum& frustum, const vec3& boxMin, const vec3& boxMax){
+    for(int i = 0; i < 6; i++){
+        const vec4& plane = frustum.planes[i];
+
+        // corner of the box the furthest along the plane normal
+        vec3 corner(plane.x >= 0.0f ? boxMax.x : boxMin.x,
+                    plane.y >= 0.0f ? boxMax.y : boxMin.y,
+                    plane.z >= 0.0f ? boxMax.z : boxMin.z);
+
+        if(plane.x * corner.x + plane.y * corner.y + plane.z * corner.z + plane.w < 0.0f){
+            return false;
+        }
+    }
+    return true;
+}
+
+void transform_aabb(const mat4& matrix, const vec3& boxMin, const vec3& boxMax, vec3& outMin, vec3& outMax){
+    // center / extent form : the new extent is |M| * extent
+    vec3 center = (boxMin + boxMax) * 0.5f;
+    vec3 extent = (boxMax - boxMin) * 0.5f;
+
+    vec4 newCenter = matrix * vec4(center, 1.0f);
+    vec3 newExtent;
+    for(int i = 0; i < 3; i++){
+        newExtent[i] = std::fabs(matrix[0][i]) * extent.x + std::fabs(matrix[1][i]) * extent.y + std::fabs(matrix[2][i]) * extent.z;
+    }
+
+    outMin = vec3(newCenter.x, newCenter.y, newCenter.z) - newExtent;
+    outMax = vec3(newCenter.x, newCenter.y, newCenter.z) + newExtent;
+}
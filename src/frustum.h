@@ -0,0 +1,17 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+// View frustum as 6 planes (a, b, c, d) with the normals pointing inside : a*x + b*y + c*z + d >= 0 inside
+struct Frustum {
+    glm::vec4 planes[6]; // left, right, bottom, top, near, far
+};
+
+// extract the planes of a projection * view matrix (Gribb / Hartmann)
+Frustum frustum_from_matrix(const glm::mat4& viewProjection);
+
+// false only if the box is completely outside one of the planes (conservative)
+bool frustum_intersects_aabb(const Frustum& frustum, const glm::vec3& boxMin, const glm::vec3& boxMax);
+
+// axis aligned box containing the transformed box
+void transform_aabb(const glm::mat4& matrix, const glm::vec3& boxMin, const glm::vec3& boxMax, glm::vec3& outMin, glm::vec3& outMax);
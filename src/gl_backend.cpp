@@ -0,0 +1,301 @@
+#include "gl_backend.h"
+
+#include <algorithm>
+
+#include "models.h"
+#include "glyph_cache.h"
+#include "telemetry.h"
+
+using namespace glm;
+
+// position (attribute 0) and color (attribute 1) interleaved, from the bound GL_ARRAY_BUFFER
+static void set_position_color_attributes(){
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 2*sizeof(vec3), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 2*sizeof(vec3), (void*)sizeof(vec3));
+    glEnableVertexAttribArray(1);
+}
+
+GLuint createCubeVertexArrayObject(bool multiColorFlag, vec3 colorVect, GLuint* vertexBufferObjectOut)
+{
+    vec3 vertexArray[72] = {};
+    cube_vertex_array(multiColorFlag, colorVect, vertexArray);
+    
+    // Create a vertex array
+    GLuint vertexArrayObject;
+    tracked_gen_vertex_arrays(1, &vertexArrayObject);
+    glBindVertexArray(vertexArrayObject);
+    
+    // Upload Vertex Buffer to the GPU, keep a reference to it (vertexBufferObject)
+    GLuint vertexBufferObject;
+    tracked_gen_buffers(1, &vertexBufferObject);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBufferObject);
+    tracked_buffer_data(GL_ARRAY_BUFFER, vertexBufferObject, sizeof(vertexArray), vertexArray, GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0,                   // attribute 0 matches aPos in Vertex Shader
+                          3,                   // size
+                          GL_FLOAT,            // type
+                          GL_FALSE,            // normalized?
+                          2*sizeof(vec3), // stride - each vertex contain 2 vec3 (position, color)
+                          (void*)0             // array buffer offset
+                          );
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribPointer(1,                            // attribute 1 matches aColor in Vertex Shader
+                          3,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          2*sizeof(vec3),
+                          (void*)sizeof(vec3)      // color is offseted a vec3 (comes after position)
+                          );
+    glEnableVertexAttribArray(1);
+    
+    *vertexBufferObjectOut = vertexBufferObject;
+    return vertexArrayObject;
+}
+
+GLRenderBackend::GLRenderBackend(GLuint shaderProgram){
+    m_worldMatrixLocation = glGetUniformLocation(shaderProgram, "worldMatrix");
+    m_viewMatrixLocation = glGetUniformLocation(shaderProgram, "viewMatrix");
+    m_projectionMatrixLocation = glGetUniformLocation(shaderProgram, "projectionMatrix");
+    m_multiViewEnabledLocation = glGetUniformLocation(shaderProgram, "multiViewEnabled");
+    m_viewIndicesLocation = glGetUniformLocation(shaderProgram, "viewIndices");
+    m_viewProjectionsLocation = glGetUniformLocation(shaderProgram, "viewProjections");
+    m_viewRectsLocation = glGetUniformLocation(shaderProgram, "viewRects");
+}
+
+void GLRenderBackend::release(){
+    std::map< std::tuple< bool, float, float, float >, CubeBuffers >::iterator ptr;
+    for (ptr = m_cubes.begin(); ptr != m_cubes.end(); ptr++){
+        tracked_delete_buffers(1, &ptr->second.vbo);
+        tracked_delete_vertex_arrays(1, &ptr->second.vao);
+        tracked_delete_buffers(1, &ptr->second.edgeVbo);
+        tracked_delete_vertex_arrays(1, &ptr->second.edgeVao);
+    }
+    m_cubes.clear();
+    m_boundCube = NULL;
+
+    if(m_edgeEbo != 0){
+        tracked_delete_buffers(1, &m_edgeEbo);
+        m_edgeEbo = 0;
+    }
+
+    if(m_batchVao != 0){
+        tracked_delete_buffers(1, &m_batchEbo);
+        tracked_delete_buffers(1, &m_batchVbo);
+        tracked_delete_vertex_arrays(1, &m_batchVao);
+        m_batchEbo = 0;
+        m_batchVbo = 0;
+        m_batchVao = 0;
+        m_batchEboCubes = 0;
+    }
+}
+
+void GLRenderBackend::begin_frame(){
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void GLRenderBackend::end_frame(){
+    // glfwSwapBuffers is done by the caller
+    flush();
+}
+
+void GLRenderBackend::flush(){
+    if(m_batchVertices.empty()){
+        return;
+    }
+
+    GLsizei cubeCount = (GLsizei)(m_batchVertices.size() / 16);
+
+    if(m_batchVao == 0){
+        tracked_gen_vertex_arrays(1, &m_batchVao);
+        glBindVertexArray(m_batchVao);
+
+        tracked_gen_buffers(1, &m_batchVbo);
+        glBindBuffer(GL_ARRAY_BUFFER, m_batchVbo);
+        set_position_color_attributes();
+
+        tracked_gen_buffers(1, &m_batchEbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_batchEbo);
+    }
+
+    glBindVertexArray(m_batchVao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_batchVbo);
+    tracked_buffer_data(GL_ARRAY_BUFFER, m_batchVbo, m_batchVertices.size() * sizeof(vec3), m_batchVertices.data(), GL_STREAM_DRAW);
+
+    // the corners are already in world space
+    mat4 identity(1.0f);
+    glUniformMatrix4fv(m_worldMatrixLocation, 1, GL_FALSE, &identity[0][0]);
+
+    if(m_mode == RENDER_LINES){
+        // the edges of cube i are the edges of the unit cube offset by 8 * i, the buffer only grows
+        if((size_t)cubeCount > m_batchEboCubes){
+            m_batchEboCubes = std::max((size_t)cubeCount, 2 * m_batchEboCubes);
+
+            std::vector< GLuint > indices;
+            indices.reserve(m_batchEboCubes * 24);
+            for(GLuint cube = 0; cube < (GLuint)m_batchEboCubes; cube++){
+                for(int i = 0; i < 24; i++){
+                    indices.push_back(cube * 8 + cubeEdgeIndices[i]);
+                }
+            }
+            tracked_buffer_data(GL_ELEMENT_ARRAY_BUFFER, m_batchEbo, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+        }
+
+        glDrawElements(GL_LINES, cubeCount * 24, GL_UNSIGNED_INT, (void*)0);
+    }
+    else{
+        glDrawArrays(GL_POINTS, 0, cubeCount * 8);
+    }
+
+    m_batchVertices.clear();
+
+    // draw_cube() in fill mode draws with the bound cube
+    if(m_boundCube != NULL){
+        glBindVertexArray(m_boundCube->vao);
+    }
+}
+
+void GLRenderBackend::set_view_projection(const mat4& viewMatrix, const mat4& projectionMatrix){
+    flush();
+    glUniformMatrix4fv(m_viewMatrixLocation, 1, GL_FALSE, &viewMatrix[0][0]);
+    glUniformMatrix4fv(m_projectionMatrixLocation, 1, GL_FALSE, &projectionMatrix[0][0]);
+}
+
+void GLRenderBackend::set_render_mode(RenderMode mode){
+    // points and lines are drawn as GL_POINTS / GL_LINES, the polygon mode stays GL_FILL
+    if(mode != m_mode){
+        flush();
+        m_mode = mode;
+    }
+}
+
+void GLRenderBackend::set_viewport(int x, int y, int width, int height){
+    flush();
+    glViewport(x, y, width, height);
+}
+
+void GLRenderBackend::bind_cube(bool multiColorFlag, vec3 colorVect){
+    std::tuple< bool, float, float, float > key(multiColorFlag, colorVect.x, colorVect.y, colorVect.z);
+
+    std::map< std::tuple< bool, float, float, float >, CubeBuffers >::iterator found = m_cubes.find(key);
+    if(found == m_cubes.end()){
+        CubeBuffers cube;
+        cube.vao = createCubeVertexArrayObject(multiColorFlag, colorVect, &cube.vbo);
+        cube_corner_array(multiColorFlag, colorVect, cube.corners);
+
+        // corners + edges, for the multi view draws in point / line mode
+        tracked_gen_vertex_arrays(1, &cube.edgeVao);
+        glBindVertexArray(cube.edgeVao);
+
+        tracked_gen_buffers(1, &cube.edgeVbo);
+        glBindBuffer(GL_ARRAY_BUFFER, cube.edgeVbo);
+        tracked_buffer_data(GL_ARRAY_BUFFER, cube.edgeVbo, sizeof(cube.corners), cube.corners, GL_STATIC_DRAW);
+        set_position_color_attributes();
+
+        // the edge indices are the same for every cube : uploaded with the first one, only bound in the others
+        bool newEdgeEbo = (m_edgeEbo == 0);
+        if(newEdgeEbo){
+            tracked_gen_buffers(1, &m_edgeEbo);
+        }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_edgeEbo);
+        if(newEdgeEbo){
+            tracked_buffer_data(GL_ELEMENT_ARRAY_BUFFER, m_edgeEbo, sizeof(cubeEdgeIndices), cubeEdgeIndices, GL_STATIC_DRAW);
+        }
+
+        found = m_cubes.insert(std::make_pair(key, cube)).first;
+    }
+
+    m_boundCube = &found->second;
+    glBindVertexArray(m_boundCube->vao);
+}
+
+void GLRenderBackend::draw_cube(const mat4& worldMatrix){
+    if(m_mode != RENDER_FILL && m_boundCube != NULL){
+        for(int i = 0; i < 16; i += 2){
+            vec4 position = worldMatrix * vec4(m_boundCube->corners[i], 1.0f);
+            m_batchVertices.push_back(vec3(position.x, position.y, position.z));
+            m_batchVertices.push_back(m_boundCube->corners[i + 1]);
+        }
+        return;
+    }
+
+    glUniformMatrix4fv(m_worldMatrixLocation, 1, GL_FALSE, &worldMatrix[0][0]);
+    glDrawArrays(GL_TRIANGLES, 0, 36);
+}
+
+void GLRenderBackend::draw_mesh(const GlyphMesh& mesh, const mat4& worldMatrix){
+    if(m_mode == RENDER_FILL){
+        draw_glyph_mesh(mesh, worldMatrix, m_worldMatrixLocation);
+        return;
+    }
+
+    // already one call per model : corners / edges of all its cubes
+    glBindVertexArray(mesh.edgeVao);
+    glUniformMatrix4fv(m_worldMatrixLocation, 1, GL_FALSE, &worldMatrix[0][0]);
+    if(m_mode == RENDER_LINES){
+        glDrawElements(GL_LINES, mesh.edgeIndexCount, GL_UNSIGNED_INT, (void*)0);
+    }
+    else{
+        glDrawArrays(GL_POINTS, 0, mesh.cornerCount);
+    }
+}
+
+// ### MULTI VIEW ###
+
+void GLRenderBackend::begin_multi_view(const mat4* viewProjections, const vec4* viewRects, int viewCount){
+    flush();
+    glUniform1i(m_multiViewEnabledLocation, 1);
+    glUniformMatrix4fv(m_viewProjectionsLocation, viewCount, GL_FALSE, &viewProjections[0][0][0]);
+    glUniform4fv(m_viewRectsLocation, viewCount, &viewRects[0][0]);
+
+    for(int i = 0; i < 4; i++){
+        glEnable(GL_CLIP_DISTANCE0 + i);
+    }
+}
+
+void GLRenderBackend::draw_cube_views(const mat4& worldMatrix, const int* viewIndices, int viewCount){
+    glUniformMatrix4fv(m_worldMatrixLocation, 1, GL_FALSE, &worldMatrix[0][0]);
+    glUniform1iv(m_viewIndicesLocation, viewCount, viewIndices);
+
+    if(m_mode == RENDER_FILL){
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 36, viewCount);
+        return;
+    }
+
+    glBindVertexArray(m_boundCube->edgeVao);
+    if(m_mode == RENDER_LINES){
+        glDrawElementsInstanced(GL_LINES, 24, GL_UNSIGNED_INT, (void*)0, viewCount);
+    }
+    else{
+        glDrawArraysInstanced(GL_POINTS, 0, 8, viewCount);
+    }
+    glBindVertexArray(m_boundCube->vao);
+}
+
+void GLRenderBackend::draw_mesh_views(const GlyphMesh& mesh, const mat4& worldMatrix, const int* viewIndices, int viewCount){
+    glUniformMatrix4fv(m_worldMatrixLocation, 1, GL_FALSE, &worldMatrix[0][0]);
+    glUniform1iv(m_viewIndicesLocation, viewCount, viewIndices);
+
+    if(m_mode == RENDER_FILL){
+        glBindVertexArray(mesh.vao);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, mesh.vertexCount, viewCount);
+    }
+    else if(m_mode == RENDER_LINES){
+        glBindVertexArray(mesh.edgeVao);
+        glDrawElementsInstanced(GL_LINES, mesh.edgeIndexCount, GL_UNSIGNED_INT, (void*)0, viewCount);
+    }
+    else{
+        glBindVertexArray(mesh.edgeVao);
+        glDrawArraysInstanced(GL_POINTS, 0, mesh.cornerCount, viewCount);
+    }
+}
+
+void GLRenderBackend::end_multi_view(){
+    for(int i = 0; i < 4; i++){
+        glDisable(GL_CLIP_DISTANCE0 + i);
+    }
+
+    glUniform1i(m_multiViewEnabledLocation, 0);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+#define GLEW_STATIC 1   // This allows linking with Static Library on Windows, without DLL
+#include <GL/glew.h>    // Include GLEW - OpenGL Extension Wrangler
+
+#include "render_backend.h"
+
+// create the VAO/VBO of the unit cube (position, color), returns the VAO (left bound)
+GLuint createCubeVertexArrayObject(bool multiColorFlag, glm::vec3 colorVect, GLuint* vertexBufferObjectOut);
+
+// Draws with the current GL context and the shader program of ass1.
+// The point and line modes draw the cube corners / edges (GL_POINTS, GL_LINES) instead of the triangles :
+// the cubes are batched (corners moved to world space on the CPU) and drawn with one call per batch.
+class GLRenderBackend : public RenderBackend {
+public:
+    GLRenderBackend(GLuint shaderProgram);
+
+    // delete the cube buffers (before the context is destroyed)
+    void release();
+
+    void begin_frame() override;
+    void end_frame() override;
+
+    // draws the pending point / line batch
+    void flush();
+
+    void set_view_projection(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) override;
+    void set_render_mode(RenderMode mode) override;
+    void set_viewport(int x, int y, int width, int height) override;
+
+    void bind_cube(bool multiColorFlag, glm::vec3 colorVect) override;
+    void draw_cube(const glm::mat4& worldMatrix) override;
+    void draw_mesh(const GlyphMesh& mesh, const glm::mat4& worldMatrix) override;
+
+    // ### MULTI VIEW ###
+    // every draw is instanced once per view it is visible in, the vertex shader moves each instance
+    // into the rectangle of its view and clips it there (gl_ClipDistance) -> all the views in a single pass
+    static const int maxViews = 4;
+
+    // viewRects : x, y, width, height in NDC of the whole framebuffer
+    void begin_multi_view(const glm::mat4* viewProjections, const glm::vec4* viewRects, int viewCount);
+    void draw_cube_views(const glm::mat4& worldMatrix, const int* viewIndices, int viewCount);
+    void draw_mesh_views(const GlyphMesh& mesh, const glm::mat4& worldMatrix, const int* viewIndices, int viewCount);
+    void end_multi_view();
+
+private:
+    struct CubeBuffers {
+        GLuint vao;
+        GLuint vbo;
+        GLuint edgeVao; // corners + m_edgeEbo
+        GLuint edgeVbo;
+        glm::vec3 corners[16]; // position, color
+    };
+
+    GLuint m_worldMatrixLocation;
+    GLuint m_viewMatrixLocation;
+    GLuint m_projectionMatrixLocation;
+    GLuint m_multiViewEnabledLocation;
+    GLuint m_viewIndicesLocation;
+    GLuint m_viewProjectionsLocation;
+    GLuint m_viewRectsLocation;
+
+    // one cube per color, created the first time the color is used
+    std::map< std::tuple< bool, float, float, float >, CubeBuffers > m_cubes;
+    const CubeBuffers* m_boundCube = NULL;
+    GLuint m_edgeEbo = 0; // cubeEdgeIndices, shared by the edge VAO of every cube
+
+    RenderMode m_mode = RENDER_FILL;
+
+    // point / line batch : corners of the cubes drawn since the last flush (world space)
+    std::vector< glm::vec3 > m_batchVertices;
+    GLuint m_batchVao = 0;
+    GLuint m_batchVbo = 0;
+    GLuint m_batchEbo = 0;
+    size_t m_batchEboCubes = 0; // number of cubes the batch element buffer has edges for
+};
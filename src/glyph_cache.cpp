@@ -0,0 +1,169 @@
+#include "glyph_cache.h"
+
+#include "models.h"
+#include "telemetry.h"
+
+using namespace glm;
+
+// ### GLYPH BAKING ###
+
+// pre-transform the cube vertices (and corners) of every segment of the glyph
+const GlyphCache::BakedGlyph& GlyphCache::bake_glyph(int segMask){
+    std::map< int, BakedGlyph >::iterator found = m_glyphs.find(segMask);
+    if(found != m_glyphs.end()){
+        return found->second;
+    }
+
+    int segFlags[7];
+    for(int i = 0; i < 7; i++){
+        segFlags[i] = (segMask >> i) & 1;
+    }
+
+    vec3 cubeArray[72] = {};
+    cube_vertex_array(true, vec3(0.0f, 0.0f, 1.0f), cubeArray);
+
+    vec3 cornerArray[16] = {};
+    cube_corner_array(true, vec3(0.0f, 0.0f, 1.0f), cornerArray);
+
+    std::vector< mat4 > matrixList = seven_seg_model(segFlags);
+
+    BakedGlyph baked;
+    baked.vertices.reserve(matrixList.size() * 72);
+    baked.corners.reserve(matrixList.size() * 16);
+
+    std::vector< mat4 >::iterator ptr;
+    for (ptr = matrixList.begin(); ptr < matrixList.end(); ptr++){
+        for(int i = 0; i < 72; i += 2){
+            vec4 position = *ptr * vec4(cubeArray[i], 1.0f);
+            baked.vertices.push_back(vec3(position.x, position.y, position.z));
+            baked.vertices.push_back(cubeArray[i + 1]); // color
+        }
+        for(int i = 0; i < 16; i += 2){
+            vec4 position = *ptr * vec4(cornerArray[i], 1.0f);
+            baked.corners.push_back(vec3(position.x, position.y, position.z));
+            baked.corners.push_back(cornerArray[i + 1]);
+        }
+    }
+
+    return m_glyphs[segMask] = baked;
+}
+
+const std::vector< vec3 >& GlyphCache::glyph(int segMask){
+    return bake_glyph(segMask).vertices;
+}
+
+const std::vector< vec3 >& GlyphCache::glyph_corners(int segMask){
+    return bake_glyph(segMask).corners;
+}
+
+GlyphMesh* GlyphCache::bake_letter_id_mesh(const std::vector< int >& segMasks, const std::vector< mat4 >& letterMatrices){
+    m_meshes.push_back(GlyphMesh());
+    GlyphMesh& mesh = m_meshes.back();
+
+    for(size_t letter = 0; letter < segMasks.size(); letter++){
+        const std::vector< vec3 >& glyphVertices = glyph(segMasks[letter]);
+        const mat4& letterMatrix = letterMatrices[letter];
+
+        for(size_t i = 0; i < glyphVertices.size(); i += 2){
+            vec4 position = letterMatrix * vec4(glyphVertices[i], 1.0f);
+            mesh.vertices.push_back(vec3(position.x, position.y, position.z));
+            mesh.vertices.push_back(glyphVertices[i + 1]);
+        }
+
+        const std::vector< vec3 >& glyphCorners = glyph_corners(segMasks[letter]);
+        for(size_t i = 0; i < glyphCorners.size(); i += 2){
+            vec4 position = letterMatrix * vec4(glyphCorners[i], 1.0f);
+            mesh.corners.push_back(vec3(position.x, position.y, position.z));
+            mesh.corners.push_back(glyphCorners[i + 1]);
+        }
+    }
+
+    mesh.vertexCount = (GLsizei)(mesh.vertices.size() / 2);
+    mesh.cornerCount = (GLsizei)(mesh.corners.size() / 2);
+
+    // same 12 edges for every cube, offset to its corners
+    for(GLuint cube = 0; cube < (GLuint)mesh.cornerCount / 8; cube++){
+        for(int i = 0; i < 24; i++){
+            mesh.edgeIndices.push_back(cube * 8 + cubeEdgeIndices[i]);
+        }
+    }
+    mesh.edgeIndexCount = (GLsizei)mesh.edgeIndices.size();
+
+    for(size_t i = 0; i < mesh.vertices.size(); i += 2){
+        mesh.boundsMin = (i == 0) ? mesh.vertices[i] : min(mesh.boundsMin, mesh.vertices[i]);
+        mesh.boundsMax = (i == 0) ? mesh.vertices[i] : max(mesh.boundsMax, mesh.vertices[i]);
+    }
+
+    return &mesh;
+}
+
+// ### GPU UPLOAD ###
+
+void GlyphCache::upload(){
+    std::list< GlyphMesh >::iterator ptr;
+    for (ptr = m_meshes.begin(); ptr != m_meshes.end(); ptr++){
+        if(ptr->vao != 0){
+            continue;
+        }
+
+        tracked_gen_vertex_arrays(1, &ptr->vao);
+        glBindVertexArray(ptr->vao);
+
+        tracked_gen_buffers(1, &ptr->vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, ptr->vbo);
+        tracked_buffer_data(GL_ARRAY_BUFFER, ptr->vbo, ptr->vertices.size() * sizeof(vec3), ptr->vertices.data(), GL_STATIC_DRAW);
+
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 2*sizeof(vec3), (void*)0);                // aPos
+        glEnableVertexAttribArray(0);
+
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 2*sizeof(vec3), (void*)sizeof(vec3));     // aColor
+        glEnableVertexAttribArray(1);
+
+        // corners + edges (the element buffer is part of the VAO state)
+        tracked_gen_vertex_arrays(1, &ptr->edgeVao);
+        glBindVertexArray(ptr->edgeVao);
+
+        tracked_gen_buffers(1, &ptr->edgeVbo);
+        glBindBuffer(GL_ARRAY_BUFFER, ptr->edgeVbo);
+        tracked_buffer_data(GL_ARRAY_BUFFER, ptr->edgeVbo, ptr->corners.size() * sizeof(vec3), ptr->corners.data(), GL_STATIC_DRAW);
+
+        tracked_gen_buffers(1, &ptr->edgeEbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ptr->edgeEbo);
+        tracked_buffer_data(GL_ELEMENT_ARRAY_BUFFER, ptr->edgeEbo, ptr->edgeIndices.size() * sizeof(GLuint), ptr->edgeIndices.data(), GL_STATIC_DRAW);
+
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 2*sizeof(vec3), (void*)0);
+        glEnableVertexAttribArray(0);
+
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 2*sizeof(vec3), (void*)sizeof(vec3));
+        glEnableVertexAttribArray(1);
+    }
+}
+
+void GlyphCache::release(){
+    std::list< GlyphMesh >::iterator ptr;
+    for (ptr = m_meshes.begin(); ptr != m_meshes.end(); ptr++){
+        if(ptr->vao == 0){
+            continue;
+        }
+
+        tracked_delete_buffers(1, &ptr->vbo);
+        tracked_delete_vertex_arrays(1, &ptr->vao);
+        ptr->vbo = 0;
+        ptr->vao = 0;
+
+        tracked_delete_buffers(1, &ptr->edgeEbo);
+        tracked_delete_buffers(1, &ptr->edgeVbo);
+        tracked_delete_vertex_arrays(1, &ptr->edgeVao);
+        ptr->edgeEbo = 0;
+        ptr->edgeVbo = 0;
+        ptr->edgeVao = 0;
+    }
+}
+
+// ### DRAWING ###
+
+void draw_glyph_mesh(const GlyphMesh& mesh, mat4 matrix, GLuint worldMatrixLocation){
+    glBindVertexArray(mesh.vao);
+    glUniformMatrix4fv(worldMatrixLocation, 1, GL_FALSE, &matrix[0][0]);
+    glDrawArrays(GL_TRIANGLES, 0, mesh.vertexCount);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <vector>
+
+#define GLEW_STATIC 1   // This allows linking with Static Library on Windows, without DLL
+#include <GL/glew.h>    // Include GLEW - OpenGL Extension Wrangler
+
+#include <glm/glm.hpp>
+
+// Merged vertex buffer of a whole model : every segment cube is already transformed into the model space,
+// so the model is drawn with a single worldMatrix upload and a single draw call
+struct GlyphMesh {
+    std::vector< glm::vec3 > vertices; // position, color (same layout as createCubeVertexArrayObject)
+
+    // bounding box in model space (for culling)
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLsizei vertexCount = 0;
+
+    // the 8 corners of every cube (position, color) and the 12 edges between them,
+    // drawn as GL_POINTS / GL_LINES in the point and line render modes
+    std::vector< glm::vec3 > corners;
+    std::vector< GLuint > edgeIndices;
+
+    GLuint edgeVao = 0;
+    GLuint edgeVbo = 0;
+    GLuint edgeEbo = 0;
+    GLsizei cornerCount = 0;
+    GLsizei edgeIndexCount = 0;
+};
+
+// Bakes the seven segment glyphs once (keyed by segment mask) and merges them into per model meshes.
+// A glyph is shared by every model that uses the same character.
+class GlyphCache {
+public:
+    // vertices of the glyph with the given segment mask, baked on first use
+    const std::vector< glm::vec3 >& glyph(int segMask);
+
+    // corners of the cubes of the glyph (8 per cube, same order as the cubes)
+    const std::vector< glm::vec3 >& glyph_corners(int segMask);
+
+    // merge the given glyphs (each placed with its letter matrix) into one mesh, the cache keeps ownership
+    GlyphMesh* bake_letter_id_mesh(const std::vector< int >& segMasks, const std::vector< glm::mat4 >& letterMatrices);
+
+    // upload the baked meshes that are not on the GPU yet (needs a current GL context)
+    void upload();
+
+    // delete the GPU buffers of every baked mesh
+    void release();
+
+    int glyph_count() const { return (int)m_glyphs.size(); }
+
+private:
+    struct BakedGlyph {
+        std::vector< glm::vec3 > vertices;
+        std::vector< glm::vec3 > corners;
+    };
+
+    const BakedGlyph& bake_glyph(int segMask);
+
+    std::map< int, BakedGlyph > m_glyphs;
+    std::list< GlyphMesh > m_meshes; // list -> pointers handed to the models stay valid
+};
+
+// draw a baked mesh with a single draw call
+void draw_glyph_mesh(const GlyphMesh& mesh, glm::mat4 matrix, GLuint worldMatrixLocation);
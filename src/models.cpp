@@ -0,0 +1,257 @@
+#include "models.h"
+
+#include <cstring>
+
+#include <glm/gtc/matrix_transform.hpp> // include this to create transformation matrices
+
+using namespace glm;
+
+// ### CUBE HELPER FUNCTIONS ###
+
+void cube_vertex_array(bool multiColorFlag, vec3 colorVect, vec3 vertexArray[72])
+{
+    vec3 whiteVect = vec3(1.0f, 1.0f, 1.0f);
+    vec3 redVect = vec3(1.0f, 0.0f, 0.0f);
+    vec3 greenVect = vec3(0.0f, 1.0f, 0.0f);
+    vec3 blueVect = vec3(0.0f, 0.0f, 1.0f);
+
+    vec3 yellowVect = vec3(1.0f, 1.0f, 0.0f);
+    vec3 lightBlueVect = vec3(0.0f, 1.0f, 1.0f);
+    vec3 pinkVect = vec3(1.0f, 0.0f, 1.0f);
+
+    // Cube model
+    vec3 specifiedColorVertexArray[] = {  // position,                            color
+        vec3(-0.5f,-0.5f,-0.5f), colorVect,
+        vec3(-0.5f,-0.5f, 0.5f), colorVect,
+        vec3(-0.5f, 0.5f, 0.5f), colorVect,
+        
+        vec3(-0.5f,-0.5f,-0.5f), colorVect,
+        vec3(-0.5f, 0.5f, 0.5f), colorVect,
+        vec3(-0.5f, 0.5f,-0.5f), colorVect,
+        
+        vec3( 0.5f, 0.5f,-0.5f), colorVect,
+        vec3(-0.5f,-0.5f,-0.5f), colorVect,
+        vec3(-0.5f, 0.5f,-0.5f), colorVect,
+        
+        vec3( 0.5f, 0.5f,-0.5f), colorVect,
+        vec3( 0.5f,-0.5f,-0.5f), colorVect,
+        vec3(-0.5f,-0.5f,-0.5f), colorVect,
+        
+        vec3( 0.5f,-0.5f, 0.5f), colorVect,
+        vec3(-0.5f,-0.5f,-0.5f), colorVect,
+        vec3( 0.5f,-0.5f,-0.5f), colorVect,
+        
+        vec3( 0.5f,-0.5f, 0.5f), colorVect,
+        vec3(-0.5f,-0.5f, 0.5f), colorVect,
+        vec3(-0.5f,-0.5f,-0.5f), colorVect,
+        
+        vec3(-0.5f, 0.5f, 0.5f), colorVect,
+        vec3(-0.5f,-0.5f, 0.5f), colorVect,
+        vec3( 0.5f,-0.5f, 0.5f), colorVect,
+        
+        vec3( 0.5f, 0.5f, 0.5f), colorVect,
+        vec3(-0.5f, 0.5f, 0.5f), colorVect,
+        vec3( 0.5f,-0.5f, 0.5f), colorVect,
+        
+        vec3( 0.5f, 0.5f, 0.5f), colorVect,
+        vec3( 0.5f,-0.5f,-0.5f), colorVect,
+        vec3( 0.5f, 0.5f,-0.5f), colorVect,
+        
+        vec3( 0.5f,-0.5f,-0.5f), colorVect,
+        vec3( 0.5f, 0.5f, 0.5f), colorVect,
+        vec3( 0.5f,-0.5f, 0.5f), colorVect,
+        
+        vec3( 0.5f, 0.5f, 0.5f), colorVect,
+        vec3( 0.5f, 0.5f,-0.5f), colorVect,
+        vec3(-0.5f, 0.5f,-0.5f), colorVect,
+        
+        vec3( 0.5f, 0.5f, 0.5f), colorVect,
+        vec3(-0.5f, 0.5f,-0.5f), colorVect,
+        vec3(-0.5f, 0.5f, 0.5f), colorVect
+    };
+
+    vec3 colorVertexArray[] = {  // position,                            color
+        vec3(-0.5f,-0.5f,-0.5f), redVect, //left - red
+        vec3(-0.5f,-0.5f, 0.5f), redVect,
+        vec3(-0.5f, 0.5f, 0.5f), redVect,
+        
+        vec3(-0.5f,-0.5f,-0.5f), redVect,
+        vec3(-0.5f, 0.5f, 0.5f), redVect,
+        vec3(-0.5f, 0.5f,-0.5f), redVect,
+        
+        vec3( 0.5f, 0.5f,-0.5f), blueVect,
+        vec3(-0.5f,-0.5f,-0.5f), blueVect,
+        vec3(-0.5f, 0.5f,-0.5f), blueVect,
+        
+        vec3( 0.5f, 0.5f,-0.5f), blueVect,
+        vec3( 0.5f,-0.5f,-0.5f), blueVect,
+        vec3(-0.5f,-0.5f,-0.5f), blueVect,
+        
+        vec3( 0.5f,-0.5f, 0.5f), greenVect, 
+        vec3(-0.5f,-0.5f,-0.5f), greenVect, 
+        vec3( 0.5f,-0.5f,-0.5f), greenVect, 
+        
+        vec3( 0.5f,-0.5f, 0.5f), greenVect, 
+        vec3(-0.5f,-0.5f, 0.5f), greenVect, 
+        vec3(-0.5f,-0.5f,-0.5f), greenVect, 
+        
+        vec3(-0.5f, 0.5f, 0.5f), yellowVect, 
+        vec3(-0.5f,-0.5f, 0.5f), yellowVect, 
+        vec3( 0.5f,-0.5f, 0.5f), yellowVect, 
+        
+        vec3( 0.5f, 0.5f, 0.5f), yellowVect, 
+        vec3(-0.5f, 0.5f, 0.5f), yellowVect, 
+        vec3( 0.5f,-0.5f, 0.5f), yellowVect, 
+        
+        vec3( 0.5f, 0.5f, 0.5f), pinkVect,
+        vec3( 0.5f,-0.5f,-0.5f), pinkVect,
+        vec3( 0.5f, 0.5f,-0.5f), pinkVect,
+        
+        vec3( 0.5f,-0.5f,-0.5f), pinkVect,
+        vec3( 0.5f, 0.5f, 0.5f), pinkVect,
+        vec3( 0.5f,-0.5f, 0.5f), pinkVect,
+        
+        vec3( 0.5f, 0.5f, 0.5f), lightBlueVect,
+        vec3( 0.5f, 0.5f,-0.5f), lightBlueVect,
+        vec3(-0.5f, 0.5f,-0.5f), lightBlueVect,
+        
+        vec3( 0.5f, 0.5f, 0.5f), lightBlueVect,
+        vec3(-0.5f, 0.5f,-0.5f), lightBlueVect,
+        vec3(-0.5f, 0.5f, 0.5f), lightBlueVect
+    };
+
+    // either choose the multi-color or single color cube
+    // either choose the multi-color or single color cube
+    if(multiColorFlag){
+        std::memcpy(vertexArray, colorVertexArray, sizeof(colorVertexArray));
+    }
+    else{
+        std::memcpy(vertexArray, specifiedColorVertexArray, sizeof(specifiedColorVertexArray));
+    }
+}
+
+void cube_corner_array(bool multiColorFlag, vec3 colorVect, vec3 cornerArray[16])
+{
+    vec3 vertexArray[72] = {};
+    cube_vertex_array(multiColorFlag, colorVect, vertexArray);
+
+    bool found[8] = {};
+    for(int i = 0; i < 72; i += 2){
+        vec3 position = vertexArray[i];
+        int corner = (position.x > 0.0f ? 4 : 0) + (position.y > 0.0f ? 2 : 0) + (position.z > 0.0f ? 1 : 0);
+        if(!found[corner]){
+            found[corner] = true;
+            cornerArray[corner * 2] = position;
+            cornerArray[corner * 2 + 1] = vertexArray[i + 1];
+        }
+    }
+}
+
+const unsigned int cubeEdgeIndices[24] = {
+    0, 1,  2, 3,  4, 5,  6, 7, // along z
+    0, 2,  1, 3,  4, 6,  5, 7, // along y
+    0, 4,  1, 5,  2, 6,  3, 7  // along x
+};
+
+// ### TRANSFORM HELPER FUNCTIONS ###
+
+// apply the transform to the given list of matrix
+std::vector< mat4 > apply_transform_2_model(std::vector< mat4 > matrixList, mat4 matrixTransform){
+    // Declaring iterator to a vector 
+    std::vector< mat4 >::iterator ptr; 
+
+    std::vector< mat4 > matrixListTransformed;
+
+    // Displaying vector elements using begin() and end() 
+    for (ptr = matrixList.begin(); ptr < matrixList.end(); ptr++){
+        mat4 matrixTransformed = matrixTransform * *ptr;
+        matrixListTransformed.push_back(matrixTransformed);
+    }
+
+    return matrixListTransformed;
+}
+
+// apply the transform to the given list of list of matrix
+std::vector< std::vector< mat4 > > apply_transform_2_models(std::vector< std::vector< mat4 > > matrixLists, mat4 matrixTransform){
+    // Declaring iterator to a vector 
+    std::vector<std::vector< mat4 >>::iterator ptr; 
+
+    std::vector< std::vector< mat4 > > matrixListsTransformed;
+
+    // Displaying vector elements using begin() and end() 
+    for (ptr = matrixLists.begin(); ptr < matrixLists.end(); ptr++){
+        std::vector<mat4> matrixListTransformed = apply_transform_2_model(*ptr, matrixTransform);
+        matrixListsTransformed.push_back(matrixListTransformed);
+    }
+
+    return matrixListsTransformed;
+}
+
+// ### MODEL DRAWING HELPER FUNCTIONS ###
+
+// draw a seven segment display (https://en.wikipedia.org/wiki/Seven-segment_display) -> given the list of which "character" to draw
+std::vector< mat4 > seven_seg_model(const int segFlags[7]){
+
+    float width = 0.1f;
+    float depth = 0.1f;
+
+    float gridUnit = 0.2f;
+
+    float height = gridUnit * 3;
+
+    std::vector< mat4 > matrixList;
+    
+    // a
+    if(segFlags[0] == 1){
+        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(0.0f, height * 2 , 0.0f)) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)) * scale(mat4(1.0f), vec3(width, height, depth));
+        matrixList.push_back(pillarWorldMatrix);
+    }
+
+    // b
+    if(segFlags[1] == 1){
+        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(height/2, height + (height/2), 0.0f))  * scale(mat4(1.0f), vec3(width, height, depth));
+        matrixList.push_back(pillarWorldMatrix);
+    }
+
+    // c
+    if(segFlags[2] == 1){
+        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(height/2, height/2, 0.0f))  * scale(mat4(1.0f), vec3(width, height, depth));
+        matrixList.push_back(pillarWorldMatrix);
+    }
+
+    // d
+    if(segFlags[3] == 1){
+        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(0.0f, 0.0f, 0.0f)) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)) * scale(mat4(1.0f), vec3(width, height, depth));
+        matrixList.push_back(pillarWorldMatrix);
+    }
+
+    // e
+    if(segFlags[4] == 1){
+        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(- height/2, height/2, 0.0f))  * scale(mat4(1.0f), vec3(width, height, depth));
+        matrixList.push_back(pillarWorldMatrix);
+    }
+
+    // f
+    if(segFlags[5] == 1){
+        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(- height/2, height + (height/2), 0.0f))  * scale(mat4(1.0f), vec3(width, height, depth));
+        matrixList.push_back(pillarWorldMatrix);
+    }
+
+    // g
+    if(segFlags[6] == 1){
+        mat4 pillarWorldMatrix = translate(mat4(1.0f), vec3(0.0f, height, 0.0f)) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)) * scale(mat4(1.0f), vec3(width, height, depth));
+        matrixList.push_back(pillarWorldMatrix);
+    }
+
+    return matrixList;
+}
+
+int seven_seg_mask(const int segFlags[7]){
+    int segMask = 0;
+    for(int i = 0; i < 7; i++){
+        if(segFlags[i] == 1){
+            segMask |= 1 << i;
+        }
+    }
+    return segMask;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Structs.
+struct GlyphMesh;
+
+struct LetterIDModel {
+    glm::mat4 og_model_matrix;  // placement of the model in the scene
+    glm::mat4 m_model_matrix;   // og_model_matrix with the input transforms applied
+
+    // we need to apply the transform on the original matrix of the model (if use on the m_model_matrix -> effect will be compounded)
+    // hence why we have a og matrix
+
+    // baked geometry of all the letters, shared between the models with the same letters
+    const GlyphMesh* mesh = nullptr;
+
+    // params
+    float scale = 1.0f;
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float angle = 1.0f;
+
+    // written every frame by the animation system (animation.h), combined with the params above
+    float orbitAngle = 0.0f; // degrees around the y axis through the ring center
+    float spinAngle = 0.0f;  // degrees around the model center, added to angle
+    float pulseScale = 1.0f; // multiplies scale
+
+    LetterIDModel(const GlyphMesh* glyph_mesh, glm::mat4 model_matrix){
+        mesh = glyph_mesh;
+        og_model_matrix = model_matrix;
+        m_model_matrix = model_matrix;
+    }
+};
+
+// ### CUBE HELPER FUNCTIONS ###
+
+// fill the given array with the 36 vertices (position, color) of the unit cube
+void cube_vertex_array(bool multiColorFlag, glm::vec3 colorVect, glm::vec3 vertexArray[72]);
+
+// fill the given array with the 8 corners (position, color) of the unit cube, corner i = (x, y, z) bits (4, 2, 1)
+// a corner takes the color of the first face of cube_vertex_array that uses it
+void cube_corner_array(bool multiColorFlag, glm::vec3 colorVect, glm::vec3 cornerArray[16]);
+
+// the 12 edges of the unit cube as pairs of corner indices (for GL_LINES)
+extern const unsigned int cubeEdgeIndices[24];
+
+// ### TRANSFORM HELPER FUNCTIONS ###
+
+std::vector< glm::mat4 > apply_transform_2_model(std::vector< glm::mat4 > matrixList, glm::mat4 matrixTransform);
+std::vector< std::vector< glm::mat4 > > apply_transform_2_models(std::vector< std::vector< glm::mat4 > > matrixLists, glm::mat4 matrixTransform);
+
+// ### MODEL DRAWING HELPER FUNCTIONS ###
+
+std::vector< glm::mat4 > seven_seg_model(const int segFlags[7]);
+
+// pack the segment flags into a bit mask (bit 0 = segment a ... bit 6 = segment g)
+int seven_seg_mask(const int segFlags[7]);
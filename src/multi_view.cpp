@@ -0,0 +1,257 @@
+#include "multi_view.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "scene.h"
+#include "frustum.h"
+#include "gl_backend.h"
+
+using namespace glm;
+
+static double ms_since(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ### RECORDING ###
+
+// backend that keeps the draws of draw_scene() instead of drawing them
+class CommandRecorder : public RenderBackend {
+public:
+    CommandRecorder(std::vector< MultiViewRenderer::Command >& commands) : m_commands(commands) {}
+
+    void begin_frame() override {}
+    void end_frame() override {}
+    void set_view_projection(const mat4&, const mat4&) override {}
+    void set_render_mode(RenderMode) override {}
+    void set_viewport(int, int, int, int) override {}
+
+    void bind_cube(bool multiColorFlag, vec3 colorVect) override {
+        m_multiColorFlag = multiColorFlag;
+        m_colorVect = colorVect;
+    }
+
+    void draw_cube(const mat4& worldMatrix) override {
+        MultiViewRenderer::Command command;
+        command.mesh = NULL;
+        command.multiColorFlag = m_multiColorFlag;
+        command.colorVect = m_colorVect;
+        command.worldMatrix = worldMatrix;
+        command.triangles = 12;
+        command.viewMask = 0;
+        transform_aabb(worldMatrix, vec3(-0.5f), vec3(0.5f), command.boundsMin, command.boundsMax);
+        m_commands.push_back(command);
+    }
+
+    void draw_mesh(const GlyphMesh& mesh, const mat4& worldMatrix) override {
+        MultiViewRenderer::Command command;
+        command.mesh = &mesh;
+        command.multiColorFlag = true;
+        command.colorVect = vec3(0.0f);
+        command.worldMatrix = worldMatrix;
+        command.triangles = mesh.vertexCount / 3;
+        command.viewMask = 0;
+        transform_aabb(worldMatrix, mesh.boundsMin, mesh.boundsMax, command.boundsMin, command.boundsMax);
+        m_commands.push_back(command);
+    }
+
+private:
+    std::vector< MultiViewRenderer::Command >& m_commands;
+    bool m_multiColorFlag = false;
+    vec3 m_colorVect = vec3(1.0f);
+};
+
+void MultiViewRenderer::prepare(const Scene& scene, const std::vector< View >& views){
+    m_views = views;
+    if((int)m_views.size() > GLRenderBackend::maxViews){
+        m_views.resize(GLRenderBackend::maxViews);
+    }
+
+    m_stats = MultiViewStats();
+    m_stats.views.resize(m_views.size());
+
+    // transforms and bounds once for all the views
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    m_commands.clear();
+    CommandRecorder recorder(m_commands);
+    draw_scene(scene, recorder);
+    m_stats.recordMs = ms_since(start);
+    m_stats.draws = (int)m_commands.size();
+
+    // cull per view
+    for(size_t v = 0; v < m_views.size(); v++){
+        start = std::chrono::steady_clock::now();
+
+        Frustum frustum = frustum_from_matrix(m_views[v].projectionMatrix * m_views[v].viewMatrix);
+        ViewStats& viewStats = m_stats.views[v];
+
+        for(size_t c = 0; c < m_commands.size(); c++){
+            Command& command = m_commands[c];
+            if(frustum_intersects_aabb(frustum, command.boundsMin, command.boundsMax)){
+                command.viewMask |= 1u << v;
+                viewStats.visibleDraws++;
+                viewStats.triangles += command.triangles;
+            }
+            else{
+                viewStats.culledDraws++;
+            }
+        }
+
+        viewStats.cullMs = ms_since(start);
+        m_stats.multiPassDraws += viewStats.visibleDraws;
+    }
+}
+
+// ### RENDERING ###
+
+void MultiViewRenderer::render_single_pass(GLRenderBackend& backend, int framebufferWidth, int framebufferHeight){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    mat4 viewProjections[GLRenderBackend::maxViews];
+    vec4 viewRects[GLRenderBackend::maxViews];
+    for(size_t v = 0; v < m_views.size(); v++){
+        const View& view = m_views[v];
+        viewProjections[v] = view.projectionMatrix * view.viewMatrix;
+        viewRects[v] = vec4(2.0f * view.x / framebufferWidth - 1.0f, 2.0f * view.y / framebufferHeight - 1.0f,
+                            2.0f * view.width / framebufferWidth, 2.0f * view.height / framebufferHeight);
+    }
+
+    backend.set_viewport(0, 0, framebufferWidth, framebufferHeight);
+    backend.begin_multi_view(viewProjections, viewRects, (int)m_views.size());
+
+    bool cubeBound = false;
+    bool boundMultiColorFlag = false;
+    vec3 boundColorVect;
+
+    for(size_t c = 0; c < m_commands.size(); c++){
+        const Command& command = m_commands[c];
+        if(command.viewMask == 0){
+            continue;
+        }
+
+        int viewIndices[GLRenderBackend::maxViews];
+        int viewCount = 0;
+        for(size_t v = 0; v < m_views.size(); v++){
+            if(command.viewMask & (1u << v)){
+                viewIndices[viewCount++] = (int)v;
+            }
+        }
+
+        if(command.mesh != NULL){
+            backend.draw_mesh_views(*command.mesh, command.worldMatrix, viewIndices, viewCount);
+            cubeBound = false; // the mesh VAO replaced the cube
+        }
+        else{
+            if(!cubeBound || boundMultiColorFlag != command.multiColorFlag || boundColorVect != command.colorVect){
+                backend.bind_cube(command.multiColorFlag, command.colorVect);
+                cubeBound = true;
+                boundMultiColorFlag = command.multiColorFlag;
+                boundColorVect = command.colorVect;
+            }
+            backend.draw_cube_views(command.worldMatrix, viewIndices, viewCount);
+        }
+        m_stats.issuedDraws++;
+    }
+
+    backend.end_multi_view();
+
+    m_stats.singlePass = true;
+    m_stats.submitMs = ms_since(start);
+}
+
+void MultiViewRenderer::render_multi_pass(RenderBackend& backend){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for(size_t v = 0; v < m_views.size(); v++){
+        const View& view = m_views[v];
+        backend.set_viewport(view.x, view.y, view.width, view.height);
+        backend.set_view_projection(view.viewMatrix, view.projectionMatrix);
+
+        for(size_t c = 0; c < m_commands.size(); c++){
+            const Command& command = m_commands[c];
+            if((command.viewMask & (1u << v)) == 0){
+                continue;
+            }
+
+            if(command.mesh != NULL){
+                backend.draw_mesh(*command.mesh, command.worldMatrix);
+            }
+            else{
+                backend.bind_cube(command.multiColorFlag, command.colorVect);
+                backend.draw_cube(command.worldMatrix);
+            }
+            m_stats.issuedDraws++;
+        }
+    }
+
+    m_stats.singlePass = false;
+    m_stats.submitMs = ms_since(start);
+}
+
+void MultiViewRenderer::print_stats() const{
+    std::printf("### Multi view (%d views, %s) ###\n", (int)m_views.size(), m_stats.singlePass ? "single instanced pass" : "one pass per view");
+    std::printf("  shared list  : %d draws recorded in %.3f ms (once for all the views)\n", m_stats.draws, m_stats.recordMs);
+
+    for(size_t v = 0; v < m_views.size(); v++){
+        const ViewStats& viewStats = m_stats.views[v];
+        std::printf("  %-12s : %4d visible, %4d culled, %7lld triangles, cull %.3f ms\n",
+                    m_views[v].name.c_str(), viewStats.visibleDraws, viewStats.culledDraws, viewStats.triangles, viewStats.cullMs);
+    }
+
+    std::printf("  draw calls   : %d issued (%d with one pass per view, %d with N full unculled passes)\n",
+                m_stats.issuedDraws, m_stats.multiPassDraws, m_stats.draws * (int)m_views.size());
+    std::printf("  submit       : %.3f ms\n", m_stats.submitMs);
+}
+
+// ### VIEWS ###
+
+std::vector< View > monitor_views(const Scene& scene, int focusLetterID, const mat4& freeViewMatrix, float fov, int framebufferWidth, int framebufferHeight){
+    int halfWidth = framebufferWidth / 2;
+    int halfHeight = framebufferHeight / 2;
+    float quarterAspect = (float)std::max(1, halfWidth) / std::max(1, halfHeight);
+
+    std::vector< View > views;
+
+    View freeView;
+    freeView.name = "free camera";
+    freeView.viewMatrix = freeViewMatrix;
+    freeView.projectionMatrix = perspective(radians(fov), (float)std::max(1, halfWidth) / std::max(1, framebufferHeight), 0.01f, 100.0f);
+    freeView.x = 0;
+    freeView.y = 0;
+    freeView.width = halfWidth;
+    freeView.height = framebufferHeight;
+    views.push_back(freeView);
+
+    View topView;
+    topView.name = "top-down";
+    topView.viewMatrix = lookAt(vec3(0.0f, 30.0f, 0.0f), vec3(0.0f), vec3(0.0f, 0.0f, -1.0f));
+    topView.projectionMatrix = perspective(radians(45.0f), quarterAspect, 0.01f, 100.0f);
+    topView.x = halfWidth;
+    topView.y = halfHeight;
+    topView.width = framebufferWidth - halfWidth;
+    topView.height = framebufferHeight - halfHeight;
+    views.push_back(topView);
+
+    // in front of the focused model, looking at the center of its letters
+    if(focusLetterID >= 0 && focusLetterID < (int)scene.list_letter_id.size()){
+        const LetterIDModel& model = scene.list_letter_id[focusLetterID];
+        vec3 target = letter_id_center(model);
+        vec4 facing = model.m_model_matrix * vec4(0.0f, 0.0f, 1.0f, 0.0f);
+        vec3 direction = normalize(vec3(facing.x, facing.y, facing.z));
+
+        View focusView;
+        focusView.name = "focus";
+        focusView.viewMatrix = lookAt(target + direction * 6.0f + vec3(0.0f, 1.5f, 0.0f), target, vec3(0.0f, 1.0f, 0.0f));
+        focusView.projectionMatrix = perspective(radians(45.0f), quarterAspect, 0.01f, 100.0f);
+        focusView.x = halfWidth;
+        focusView.y = 0;
+        focusView.width = framebufferWidth - halfWidth;
+        focusView.height = halfHeight;
+        views.push_back(focusView);
+    }
+
+    return views;
+}
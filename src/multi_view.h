@@ -0,0 +1,76 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "render_backend.h"
+
+struct Scene;
+struct GlyphMesh;
+class GLRenderBackend;
+
+// one camera drawn in a rectangle of the framebuffer
+struct View {
+    std::string name;
+    glm::mat4 viewMatrix;
+    glm::mat4 projectionMatrix;
+    int x, y, width, height; // viewport in pixels (from the bottom left corner)
+};
+
+struct ViewStats {
+    int visibleDraws = 0;
+    int culledDraws = 0;
+    long long triangles = 0;
+    double cullMs = 0.0;
+};
+
+struct MultiViewStats {
+    int draws = 0;             // commands in the shared list
+    int issuedDraws = 0;       // draw calls issued for all the views
+    int multiPassDraws = 0;    // draw calls N full passes would issue (visible draws of every view)
+    double recordMs = 0.0;     // scene recorded once (world matrices + world bounds) for all the views
+    double submitMs = 0.0;
+    bool singlePass = false;
+    std::vector< ViewStats > views;
+};
+
+// Draws several views of the scene from one shared command list :
+// the scene is recorded once, each draw is culled against every view (view mask),
+// then the list is drawn either in a single instanced pass (GL) or once per view (any backend, reference).
+class MultiViewRenderer {
+public:
+    // record the scene (update_scene() already applied) and cull every draw against the views
+    void prepare(const Scene& scene, const std::vector< View >& views);
+
+    // one instanced draw per command, one instance per view it is visible in
+    void render_single_pass(GLRenderBackend& backend, int framebufferWidth, int framebufferHeight);
+
+    // replay the visible commands once per view
+    void render_multi_pass(RenderBackend& backend);
+
+    const MultiViewStats& stats() const { return m_stats; }
+    void print_stats() const;
+
+private:
+    struct Command {
+        const GlyphMesh* mesh; // NULL -> unit cube
+        bool multiColorFlag;
+        glm::vec3 colorVect;
+        glm::mat4 worldMatrix;
+        glm::vec3 boundsMin;   // world space
+        glm::vec3 boundsMax;
+        int triangles;
+        unsigned viewMask;
+    };
+
+    friend class CommandRecorder;
+
+    std::vector< Command > m_commands;
+    std::vector< View > m_views;
+    MultiViewStats m_stats;
+};
+
+// monitoring layout : free camera on the left half, top-down view top right, focused model (keys 1-5) bottom right
+std::vector< View > monitor_views(const Scene& scene, int focusLetterID, const glm::mat4& freeViewMatrix, float fov, int framebufferWidth, int framebufferHeight);
@@ -0,0 +1,312 @@
+#include "occlusion.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "scene.h"
+#include "camera.h"
+#include "glyph_cache.h"
+
+using namespace glm;
+
+static double ms_since(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+OcclusionCuller::OcclusionCuller(int width, int height){
+    m_width = width;
+    m_height = height;
+
+    // mip chain down to 1x1
+    int levelWidth = width;
+    int levelHeight = height;
+    while(true){
+        m_levels.push_back(std::vector< float >(levelWidth * levelHeight, 1.0f));
+        m_levelWidths.push_back(levelWidth);
+        m_levelHeights.push_back(levelHeight);
+
+        if(levelWidth == 1 && levelHeight == 1){
+            break;
+        }
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+    }
+}
+
+// ### DEPTH BUFFER ###
+
+void OcclusionCuller::clear(){
+    std::fill(m_levels[0].begin(), m_levels[0].end(), 1.0f);
+}
+
+// the two triangles share an edge and lie in the same plane (a face of a cube) -> one convex quad
+static bool is_quad(const vec3* vertices, int first){
+    const vec3& p0 = vertices[first * 2];
+    const vec3& p1 = vertices[(first + 1) * 2];
+    const vec3& p2 = vertices[(first + 2) * 2];
+
+    int shared = 0;
+    vec3 other;
+    for(int k = 3; k < 6; k++){
+        const vec3& q = vertices[(first + k) * 2];
+        if(q == p0 || q == p1 || q == p2){
+            shared++;
+        }
+        else{
+            other = q;
+        }
+    }
+    if(shared != 2){
+        return false;
+    }
+
+    vec3 normal = cross(p1 - p0, p2 - p0);
+    float scale = length(normal) * (length(p1 - p0) + length(p2 - p0));
+    return std::fabs(dot(normal, other - p0)) <= 1.0e-4f * scale;
+}
+
+void OcclusionCuller::rasterize_occluder(const GlyphMesh& mesh, const mat4& modelViewProjection){
+    std::vector< float >& depth = m_levels[0];
+    const vec3* vertices = mesh.vertices.data();
+
+    // one face at a time : a lone triangle or a quad made of two triangles
+    int first = 0;
+    while(first + 2 < mesh.vertexCount){
+        int triangleCount = (first + 5 < mesh.vertexCount && is_quad(vertices, first)) ? 2 : 1;
+        int vertexCount = triangleCount * 3;
+
+        float sx[6], sy[6], sz[6];
+        bool clipped = false;
+        for(int k = 0; k < vertexCount; k++){
+            vec4 clip = modelViewProjection * vec4(vertices[(first + k) * 2], 1.0f);
+
+            // skipping part of an occluder is always safe (it only hides less)
+            if(clip.w <= 1.0e-4f || clip.z < -clip.w){
+                clipped = true;
+                break;
+            }
+
+            float invW = 1.0f / clip.w;
+            sx[k] = (clip.x * invW * 0.5f + 0.5f) * m_width;
+            sy[k] = (clip.y * invW * 0.5f + 0.5f) * m_height;
+            sz[k] = clip.z * invW * 0.5f + 0.5f;
+        }
+        first += vertexCount;
+
+        // back facing (counter clockwise = front), the front faces hide the same pixels
+        float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sy[1] - sy[0]) * (sx[2] - sx[0]);
+        if(clipped || area <= 0.0f){
+            continue;
+        }
+
+        float minX = sx[0], maxX = sx[0], minY = sy[0], maxY = sy[0], maxDepth = sz[0];
+        for(int k = 1; k < vertexCount; k++){
+            minX = std::min(minX, sx[k]);
+            maxX = std::max(maxX, sx[k]);
+            minY = std::min(minY, sy[k]);
+            maxY = std::max(maxY, sy[k]);
+            maxDepth = std::max(maxDepth, sz[k]);
+        }
+
+        int x0 = std::max(0, (int)std::floor(minX));
+        int y0 = std::max(0, (int)std::floor(minY));
+        int x1 = std::min(m_width - 1, (int)std::floor(maxX));
+        int y1 = std::min(m_height - 1, (int)std::floor(maxY));
+        if(x0 > x1 || y0 > y1){
+            continue;
+        }
+
+        // edge j of each triangle : a * x + b * y + c >= 0 inside
+        float a[6], b[6], c[6];
+        for(int t = 0; t < triangleCount; t++){
+            for(int j = 0; j < 3; j++){
+                int from = t * 3 + j;
+                int to = t * 3 + (j + 1) % 3;
+                a[from] = -(sy[to] - sy[from]);
+                b[from] = sx[to] - sx[from];
+                c[from] = -(a[from] * sx[from] + b[from] * sy[from]);
+            }
+        }
+
+        // depth plane of the face, and the farthest depth of the plane over a pixel
+        float dzdx = ((sz[1] - sz[0]) * (sy[2] - sy[0]) - (sz[2] - sz[0]) * (sy[1] - sy[0])) / area;
+        float dzdy = ((sx[1] - sx[0]) * (sz[2] - sz[0]) - (sx[2] - sx[0]) * (sz[1] - sz[0])) / area;
+        float depthMargin = 0.5f * (std::fabs(dzdx) + std::fabs(dzdy));
+
+        for(int y = y0; y <= y1; y++){
+            for(int x = x0; x <= x1; x++){
+                // the face is convex : the pixel is completely covered if its 4 corners are inside it
+                bool covered = true;
+                for(int corner = 0; corner < 4 && covered; corner++){
+                    float px = (float)(x + (corner & 1));
+                    float py = (float)(y + (corner >> 1));
+
+                    bool inside = false;
+                    for(int t = 0; t < triangleCount && !inside; t++){
+                        inside = a[t * 3] * px + b[t * 3] * py + c[t * 3] >= 0.0f &&
+                                 a[t * 3 + 1] * px + b[t * 3 + 1] * py + c[t * 3 + 1] >= 0.0f &&
+                                 a[t * 3 + 2] * px + b[t * 3 + 2] * py + c[t * 3 + 2] >= 0.0f;
+                    }
+                    covered = inside;
+                }
+                if(!covered){
+                    continue;
+                }
+
+                float px = x + 0.5f;
+                float py = y + 0.5f;
+                float z = std::min(maxDepth, sz[0] + dzdx * (px - sx[0]) + dzdy * (py - sy[0]) + depthMargin);
+                float& stored = depth[y * m_width + x];
+                stored = std::min(stored, z);
+            }
+        }
+    }
+}
+
+void OcclusionCuller::build_mip_chain(){
+    for(size_t level = 1; level < m_levels.size(); level++){
+        const std::vector< float >& src = m_levels[level - 1];
+        int srcWidth = m_levelWidths[level - 1];
+        int srcHeight = m_levelHeights[level - 1];
+
+        std::vector< float >& dst = m_levels[level];
+        int dstWidth = m_levelWidths[level];
+        int dstHeight = m_levelHeights[level];
+
+        for(int y = 0; y < dstHeight; y++){
+            int y0 = y * 2;
+            int y1 = std::min(y0 + 1, srcHeight - 1);
+            for(int x = 0; x < dstWidth; x++){
+                int x0 = x * 2;
+                int x1 = std::min(x0 + 1, srcWidth - 1);
+                dst[y * dstWidth + x] = std::max(std::max(src[y0 * srcWidth + x0], src[y0 * srcWidth + x1]),
+                                                 std::max(src[y1 * srcWidth + x0], src[y1 * srcWidth + x1]));
+            }
+        }
+    }
+}
+
+// ### TESTS ###
+
+bool OcclusionCuller::box_visible(const vec3& boxMin, const vec3& boxMax, const mat4& viewProjection, float& screenArea) const{
+    float minX = 1.0f, minY = 1.0f, maxX = -1.0f, maxY = -1.0f;
+    float minZ = 1.0f;
+
+    for(int i = 0; i < 8; i++){
+        vec3 corner((i & 4) ? boxMax.x : boxMin.x, (i & 2) ? boxMax.y : boxMin.y, (i & 1) ? boxMax.z : boxMin.z);
+        vec4 clip = viewProjection * vec4(corner, 1.0f);
+
+        // crosses the near plane -> can't be projected, keep it
+        if(clip.w <= 1.0e-4f || clip.z < -clip.w){
+            screenArea = 1.0f;
+            return true;
+        }
+
+        float invW = 1.0f / clip.w;
+        minX = std::min(minX, clip.x * invW);
+        maxX = std::max(maxX, clip.x * invW);
+        minY = std::min(minY, clip.y * invW);
+        maxY = std::max(maxY, clip.y * invW);
+        minZ = std::min(minZ, clip.z * invW * 0.5f + 0.5f);
+    }
+
+    minX = std::max(minX, -1.0f);
+    minY = std::max(minY, -1.0f);
+    maxX = std::min(maxX, 1.0f);
+    maxY = std::min(maxY, 1.0f);
+    screenArea = std::max(0.0f, maxX - minX) * std::max(0.0f, maxY - minY) * 0.25f;
+
+    int x0 = std::max(0, std::min(m_width - 1, (int)std::floor((minX * 0.5f + 0.5f) * m_width)));
+    int x1 = std::max(0, std::min(m_width - 1, (int)std::floor((maxX * 0.5f + 0.5f) * m_width)));
+    int y0 = std::max(0, std::min(m_height - 1, (int)std::floor((minY * 0.5f + 0.5f) * m_height)));
+    int y1 = std::max(0, std::min(m_height - 1, (int)std::floor((maxY * 0.5f + 0.5f) * m_height)));
+
+    // coarsest level where the box covers at most 4x4 texels
+    int level = 0;
+    while(((x1 >> level) - (x0 >> level)) > 3 || ((y1 >> level) - (y0 >> level)) > 3){
+        level++;
+    }
+
+    const std::vector< float >& depth = m_levels[level];
+    int levelWidth = m_levelWidths[level];
+    for(int y = y0 >> level; y <= (y1 >> level); y++){
+        for(int x = x0 >> level; x <= (x1 >> level); x++){
+            if(minZ <= depth[y * levelWidth + x]){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void OcclusionCuller::cull_scene(const Scene& scene, const Camera& camera){
+    m_stats = Stats();
+    const mat4& viewProjection = camera.view_projection();
+    const std::vector< LetterIDModel >& models = scene.list_letter_id;
+
+    // 1. + 2. occluders of the previous frame, with this frame's transforms
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    clear();
+    for(size_t i = 0; i < m_occluders.size(); i++){
+        if(m_occluders[i] >= (int)models.size()){
+            continue;
+        }
+        const LetterIDModel& model = models[m_occluders[i]];
+        rasterize_occluder(*model.mesh, viewProjection * model.m_model_matrix);
+        m_stats.occluders++;
+        m_stats.occluderTriangles += model.mesh->vertexCount / 3;
+    }
+    build_mip_chain();
+    m_stats.rasterMs = ms_since(start);
+
+    // 3. frustum, then occlusion
+    start = std::chrono::steady_clock::now();
+    const Frustum& frustum = camera.frustum();
+
+    m_visible.assign(models.size(), false);
+    std::vector< std::pair< float, int > > candidates;
+
+    for(size_t i = 0; i < models.size(); i++){
+        const LetterIDModel& model = models[i];
+        vec3 boxMin, boxMax;
+        transform_aabb(model.m_model_matrix, model.mesh->boundsMin, model.mesh->boundsMax, boxMin, boxMax);
+        m_stats.tested++;
+
+        if(!frustum_intersects_aabb(frustum, boxMin, boxMax)){
+            m_stats.frustumCulled++;
+            continue;
+        }
+
+        float screenArea = 0.0f;
+        if(!box_visible(boxMin, boxMax, viewProjection, screenArea)){
+            m_stats.occluded++;
+            continue;
+        }
+
+        m_visible[i] = true;
+        if(screenArea >= minOccluderArea){
+            candidates.push_back(std::make_pair(screenArea, (int)i));
+        }
+    }
+
+    // the largest visible models hide the most -> occluders of the next frame
+    std::sort(candidates.begin(), candidates.end(), [](const std::pair< float, int >& a, const std::pair< float, int >& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    });
+    m_occluders.clear();
+    for(size_t i = 0; i < candidates.size() && (int)i < maxOccluders; i++){
+        m_occluders.push_back(candidates[i].second);
+    }
+
+    m_stats.drawCallsSaved = m_stats.occluded;
+    m_stats.testMs = ms_since(start);
+}
+
+void OcclusionCuller::print_stats() const{
+    std::printf("### Occlusion culling (%dx%d, %d levels) ###\n", m_width, m_height, (int)m_levels.size());
+    std::printf("  occluders    : %d (%lld triangles), rasterized in %.3f ms\n", m_stats.occluders, m_stats.occluderTriangles, m_stats.rasterMs);
+    std::printf("  models       : %d tested, %d outside the frustum, %d occluded in %.3f ms\n", m_stats.tested, m_stats.frustumCulled, m_stats.occluded, m_stats.testMs);
+    std::printf("  draw calls   : %d saved by occlusion\n", m_stats.drawCallsSaved);
+}
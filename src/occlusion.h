@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "frustum.h"
+
+struct Scene;
+struct GlyphMesh;
+class Camera;
+
+// CPU occlusion culling of the letter/id models. Every frame :
+//   1. the large models that were visible in the previous frame (the occluders) are rasterized
+//      into a low resolution depth buffer with this frame's camera, conservatively : only the pixels
+//      a face (triangle, or quad of two coplanar triangles) covers completely, with its farthest depth over the pixel
+//   2. a max depth mip chain is built from it (hierarchical depth buffer)
+//   3. each model is tested against the frustum, then its bounding box against the mip level where
+//      it covers at most 4x4 texels : hidden if its closest point is behind all of them
+class OcclusionCuller {
+public:
+    struct Stats {
+        int occluders = 0;
+        long long occluderTriangles = 0;
+        int tested = 0;
+        int frustumCulled = 0;
+        int occluded = 0;
+        int drawCallsSaved = 0; // by the occlusion test only (one draw call per model), frustum rejects are frustumCulled
+        double rasterMs = 0.0;  // occluders + mip chain
+        double testMs = 0.0;
+    };
+
+    OcclusionCuller(int width = 256, int height = 192);
+
+    // decide which models of the scene are drawn this frame (update_scene() already applied)
+    void cull_scene(const Scene& scene, const Camera& camera);
+
+    // one flag per model of scene.list_letter_id (for draw_scene())
+    const std::vector< bool >& visible_models() const { return m_visible; }
+
+    const Stats& stats() const { return m_stats; }
+    void print_stats() const;
+
+    // how many visible models are kept as occluders for the next frame, and how large they must be on screen
+    int maxOccluders = 8;
+    float minOccluderArea = 0.01f; // fraction of the screen covered by the projected bounding box
+
+private:
+    void clear();
+    void rasterize_occluder(const GlyphMesh& mesh, const glm::mat4& modelViewProjection);
+    void build_mip_chain();
+
+    // false if the world space box is completely behind the occluders
+    bool box_visible(const glm::vec3& boxMin, const glm::vec3& boxMax, const glm::mat4& viewProjection, float& screenArea) const;
+
+    int m_width;
+    int m_height;
+
+    // level 0 is the depth buffer, level i + 1 keeps the max of 2x2 texels of level i
+    std::vector< std::vector< float > > m_levels;
+    std::vector< int > m_levelWidths;
+    std::vector< int > m_levelHeights;
+
+    std::vector< int > m_occluders; // model indices, chosen in the previous frame
+    std::vector< bool > m_visible;
+    Stats m_stats;
+};
@@ -0,0 +1,125 @@
+#include "program_cache.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "telemetry.h"
+
+// file layout : magic, version, key, binary format, binary length, binary
+static const char programCacheMagic[4] = {'A', '1', 'P', 'B'};
+static const uint32_t programCacheVersion = 1;
+
+// FNV-1a, enough to tell shader sources / drivers apart
+static uint64_t hash_string(uint64_t hash, const char* str){
+    if(str == NULL){
+        return hash;
+    }
+
+    for(const unsigned char* c = (const unsigned char*)str; *c != 0; c++){
+        hash ^= *c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool program_binary_supported(){
+    if(!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary){
+        return false;
+    }
+
+    GLint numFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+    return numFormats > 0;
+}
+
+uint64_t program_cache_key(const char* vertexShaderSource, const char* fragmentShaderSource){
+    uint64_t hash = 14695981039346656037ull;
+    hash = hash_string(hash, vertexShaderSource);
+    hash = hash_string(hash, fragmentShaderSource);
+    hash = hash_string(hash, (const char*)glGetString(GL_VENDOR));
+    hash = hash_string(hash, (const char*)glGetString(GL_RENDERER));
+    hash = hash_string(hash, (const char*)glGetString(GL_VERSION));
+    return hash;
+}
+
+GLuint load_program_binary(const std::string& path, uint64_t key){
+    if(!program_binary_supported()){
+        return 0;
+    }
+
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if(!file){
+        return 0;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    uint64_t fileKey = 0;
+    uint32_t format = 0;
+    uint32_t length = 0;
+
+    file.read(magic, sizeof(magic));
+    file.read((char*)&version, sizeof(version));
+    file.read((char*)&fileKey, sizeof(fileKey));
+    file.read((char*)&format, sizeof(format));
+    file.read((char*)&length, sizeof(length));
+
+    if(!file || std::memcmp(magic, programCacheMagic, sizeof(magic)) != 0 || version != programCacheVersion || fileKey != key || length == 0){
+        return 0; // stale or foreign file -> recompile
+    }
+
+    std::vector<char> binary(length);
+    file.read(binary.data(), length);
+    if(!file){
+        return 0;
+    }
+
+    GLuint program = tracked_create_program();
+    glProgramBinary(program, (GLenum)format, binary.data(), (GLsizei)length);
+
+    // the driver can still reject the binary (ex: after a driver update with the same version string)
+    int success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if(!success){
+        tracked_delete_program(program);
+        return 0;
+    }
+
+    return program;
+}
+
+bool save_program_binary(GLuint program, const std::string& path, uint64_t key){
+    if(!program_binary_supported()){
+        return false;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if(length <= 0){
+        return false;
+    }
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, NULL, &format, binary.data());
+
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    if(!file){
+        std::cerr << "WARNING::PROGRAM_CACHE::CANNOT_WRITE " << path << std::endl;
+        return false;
+    }
+
+    uint32_t fileFormat = format;
+    uint32_t fileLength = length;
+
+    file.write(programCacheMagic, sizeof(programCacheMagic));
+    file.write((const char*)&programCacheVersion, sizeof(programCacheVersion));
+    file.write((const char*)&key, sizeof(key));
+    file.write((const char*)&fileFormat, sizeof(fileFormat));
+    file.write((const char*)&fileLength, sizeof(fileLength));
+    file.write(binary.data(), length);
+
+    return (bool)file;
+}
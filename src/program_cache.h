@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#define GLEW_STATIC 1   // This allows linking with Static Library on Windows, without DLL
+#include <GL/glew.h>    // Include GLEW - OpenGL Extension Wrangler
+
+// On disk cache of the linked shader program (glGetProgramBinary / glProgramBinary).
+// The binary is only valid for the same shader sources and the same driver -> both are part of the key.
+
+// true if the driver can give back program binaries (GL 4.1 or ARB_get_program_binary, with at least 1 format)
+bool program_binary_supported();
+
+// key of the program : hash of the shader sources + GL vendor/renderer/version (needs a current context)
+uint64_t program_cache_key(const char* vertexShaderSource, const char* fragmentShaderSource);
+
+// load the program from the cache file, returns 0 if there is no valid binary (caller then compiles the shaders)
+GLuint load_program_binary(const std::string& path, uint64_t key);
+
+// write the binary of the linked program to the cache file
+bool save_program_binary(GLuint program, const std::string& path, uint64_t key);
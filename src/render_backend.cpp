@@ -0,0 +1,29 @@
+#include "render_backend.h"
+
+using namespace glm;
+
+// ### DRAWING HELPER FUNCTIONS ###
+
+void draw_matrix(const mat4& matrix, RenderBackend& backend){
+    backend.draw_cube(matrix);
+}
+
+void draw_model(const std::vector< mat4 >& matrixList, RenderBackend& backend){
+    // Declaring iterator to a vector
+    std::vector< mat4 >::const_iterator ptr;
+
+    // Displaying vector elements using begin() and end()
+    for (ptr = matrixList.begin(); ptr < matrixList.end(); ptr++){
+        draw_matrix(*ptr, backend);
+    }
+}
+
+void draw_models(const std::vector< std::vector< mat4 >>& matrixLists, RenderBackend& backend){
+    // Declaring iterator to a vector
+    std::vector<std::vector< mat4 >>::const_iterator ptr;
+
+    // Displaying vector elements using begin() and end()
+    for (ptr = matrixLists.begin(); ptr < matrixLists.end(); ptr++){
+        draw_model(*ptr, backend);
+    }
+}
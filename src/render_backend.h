@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+struct GlyphMesh;
+
+// same as the p/l/t keys (glPolygonMode)
+enum RenderMode {
+    RENDER_POINTS,
+    RENDER_LINES,
+    RENDER_FILL
+};
+
+// What the draw functions talk to : the OpenGL context (GLRenderBackend) or the CPU reference rasterizer (SoftwareRasterizer).
+// Both draw the same cube meshes with depth test (GL_LESS) and back-face culling (counter clockwise = front).
+class RenderBackend {
+public:
+    virtual ~RenderBackend() {}
+
+    // clear color and depth
+    virtual void begin_frame() = 0;
+
+    // everything drawn in the frame has been submitted
+    virtual void end_frame() = 0;
+
+    virtual void set_view_projection(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) = 0;
+    virtual void set_render_mode(RenderMode mode) = 0;
+
+    // rectangle of the framebuffer the next draws go to (glViewport, pixels from the bottom left corner)
+    virtual void set_viewport(int x, int y, int width, int height) = 0;
+
+    // select the unit cube used by draw_matrix (same parameters as createCubeVertexArrayObject)
+    virtual void bind_cube(bool multiColorFlag, glm::vec3 colorVect) = 0;
+
+    // draw the bound cube with the given world matrix
+    virtual void draw_cube(const glm::mat4& worldMatrix) = 0;
+
+    // draw a baked mesh with the given world matrix
+    virtual void draw_mesh(const GlyphMesh& mesh, const glm::mat4& worldMatrix) = 0;
+};
+
+// ### DRAWING HELPER FUNCTIONS ###
+
+// draw the given matrix
+void draw_matrix(const glm::mat4& matrix, RenderBackend& backend);
+
+// draw the given list of matrix
+void draw_model(const std::vector< glm::mat4 >& matrixList, RenderBackend& backend);
+
+// draw the given list of list of matrix
+void draw_models(const std::vector< std::vector< glm::mat4 >>& matrixLists, RenderBackend& backend);
@@ -0,0 +1,204 @@
+#include "scene.h"
+
+#include <glm/gtc/matrix_transform.hpp> // include this to create transformation matrices
+
+using namespace glm;
+
+std::vector< mat4 > build_grid_model(int gridSize, float gridUnit){
+    std::vector< mat4 > gridMatrixList;
+    gridMatrixList.reserve(gridSize * 2);
+
+    for (int i=0; i<(gridSize/2); ++i)
+    {
+        mat4 zAxisLineMatrix = translate(mat4(1.0f), vec3(0.0f + (i * gridUnit), 0.0f, 0.0f)) * scale(mat4(1.0f), vec3(0.01f, 0.01f, gridUnit * gridSize));
+
+        // turn 90
+        mat4 xAxisLineMatrix = translate(mat4(1.0f), vec3(0.0f, 0.0f, 0.0f + (i * gridUnit))) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)) * scale(mat4(1.0f), vec3(0.01f, 0.01f, gridUnit * gridSize));
+
+        gridMatrixList.push_back(zAxisLineMatrix);
+        gridMatrixList.push_back(xAxisLineMatrix);
+    }
+
+    for (int i=0; i<(gridSize/2); ++i)
+    {
+        mat4 zAxisLineMatrix = translate(mat4(1.0f), vec3(0.0f + (-i * gridUnit), 0.0f, 0.0f)) * scale(mat4(1.0f), vec3(0.01f, 0.01f, gridUnit * gridSize));
+
+        // turn 90
+        mat4 xAxisLineMatrix = translate(mat4(1.0f), vec3(0.0f, 0.0f, 0.0f + (-i * gridUnit))) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)) * scale(mat4(1.0f), vec3(0.01f, 0.01f, gridUnit * gridSize));
+
+        gridMatrixList.push_back(zAxisLineMatrix);
+        gridMatrixList.push_back(xAxisLineMatrix);
+    }
+
+    return gridMatrixList;
+}
+
+void build_scene(Scene& scene){
+    float gridUnit = scene.gridUnit;
+
+    // Make Grid
+    scene.og_gridMatrixList = build_grid_model(scene.gridSize, gridUnit);
+
+    // Make Axis
+    float lengthAxis = gridUnit * 7;
+
+    scene.og_yAxisMatrix = translate(mat4(1.0f), vec3(0.0f , lengthAxis/2, 0.0f)) * scale(mat4(1.0f), vec3(0.05f, lengthAxis, 0.05f));
+    scene.og_xAxisMatrix = translate(mat4(1.0f), vec3(lengthAxis/2 , 0.0f, 0.0f)) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)) * scale(mat4(1.0f), vec3(0.05f, lengthAxis, 0.05f));
+    scene.og_zAxisMatrix = translate(mat4(1.0f), vec3(0.0f , 0.0f, lengthAxis/2)) * rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f)) * scale(mat4(1.0f), vec3(0.05f, lengthAxis, 0.05f));
+
+    // Init Letters
+    std::vector<int> letter_id_masks;
+    std::vector<mat4> letter_id_offsets;
+    mat4 translateMatrix;
+    mat4 rotateMatrixInit;
+
+    int segP[] = {1,1,0,0,1,1,1};
+    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * 5), (gridUnit * 0), (gridUnit * 0)));
+    letter_id_masks.push_back(seven_seg_mask(segP));
+    letter_id_offsets.push_back(translateMatrix);
+
+    int segE[] = {1,0,0,1,1,1,1};
+    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * 10), (gridUnit * 0), (gridUnit * 0)));
+    letter_id_masks.push_back(seven_seg_mask(segE));
+    letter_id_offsets.push_back(translateMatrix);
+
+    // Init ID
+    int seg2[] = {1,1,0,1,1,0,1};
+    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * 17), (gridUnit * 0), (gridUnit * 0)));
+    letter_id_masks.push_back(seven_seg_mask(seg2));
+    letter_id_offsets.push_back(translateMatrix);
+
+    int seg8[] = {1,1,1,1,1,1,1};
+    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * 22), (gridUnit * 0), (gridUnit * 0)));
+    letter_id_masks.push_back(seven_seg_mask(seg8));
+    letter_id_offsets.push_back(translateMatrix);
+
+    // Bake the letters once -> every model with the same letters shares the mesh
+    GlyphMesh* letterIDMesh = scene.glyphCache.bake_letter_id_mesh(letter_id_masks, letter_id_offsets);
+
+    // List of Letter/ID
+    std::vector< LetterIDModel >& list_letter_id = scene.list_letter_id;
+    int circleDistance = scene.circleDistance;
+    int offsetDistance = 15; // to correct when we rotate the 3 and 6 o clock models, to be relatively centered with regard to x-axis
+
+    // 12 o clock letter/id
+    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * 0), (gridUnit * 0), (gridUnit * -circleDistance)));
+    list_letter_id.push_back(LetterIDModel(letterIDMesh, translateMatrix));
+
+    // 6 o clock letter/id
+    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * offsetDistance), (gridUnit * 0), (gridUnit * circleDistance)));
+    rotateMatrixInit = rotate(glm::mat4(1.0f), glm::radians(-180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    list_letter_id.push_back(LetterIDModel(letterIDMesh, translateMatrix * rotateMatrixInit));
+
+    // 3 o clock letter/id
+    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * circleDistance), (gridUnit * 0), (gridUnit * -offsetDistance)));
+    rotateMatrixInit = rotate(glm::mat4(1.0f), glm::radians(-90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    list_letter_id.push_back(LetterIDModel(letterIDMesh, translateMatrix * rotateMatrixInit));
+
+    // 9 o clock letter/id
+    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * -circleDistance), (gridUnit * 0), (gridUnit * offsetDistance)));
+    rotateMatrixInit = rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    list_letter_id.push_back(LetterIDModel(letterIDMesh, translateMatrix * rotateMatrixInit));
+
+    // middle letter/id
+    translateMatrix = translate(mat4(1.0f), vec3((gridUnit * 0), (gridUnit * 0), (gridUnit * 0)));
+    list_letter_id.push_back(LetterIDModel(letterIDMesh, translateMatrix));
+}
+
+int add_ring_models(Scene& scene, int count){
+    std::vector< LetterIDModel >& list_letter_id = scene.list_letter_id;
+    int firstModel = (int)list_letter_id.size();
+    if(count <= 0 || list_letter_id.empty()){
+        return firstModel;
+    }
+
+    // before taking a reference to the first model
+    list_letter_id.reserve(firstModel + count);
+
+    const LetterIDModel& source = list_letter_id[0];
+    vec3 center = (source.mesh->boundsMin + source.mesh->boundsMax) * 0.5f;
+    float height = source.mesh->boundsMax.y - source.mesh->boundsMin.y;
+
+    const int modelsPerLayer = 24;
+    const float ringScale = 0.4f;
+    float radius = scene.gridUnit * scene.circleDistance;
+
+    for(int i = 0; i < count; i++){
+        int layer = i / modelsPerLayer;
+        float ringAngle = 360.0f * (i % modelsPerLayer) / modelsPerLayer + (layer % 2) * 180.0f / modelsPerLayer;
+
+        // 12 o clock is at -z, turning clockwise seen from above (like the 3 o clock model)
+        vec3 position(radius * sinf(radians(ringAngle)), height * ringScale * (0.5f + 1.25f * layer), -radius * cosf(radians(ringAngle)));
+        mat4 placementMatrix = translate(mat4(1.0f), position) * rotate(glm::mat4(1.0f), glm::radians(-ringAngle), glm::vec3(0.0f, 1.0f, 0.0f)) *
+                               scale(mat4(1.0f), vec3(ringScale)) * translate(mat4(1.0f), -center);
+
+        list_letter_id.push_back(LetterIDModel(source.mesh, placementMatrix));
+    }
+
+    return firstModel;
+}
+
+void update_scene(Scene& scene, float worldAngleX, float worldAngleY){
+    // world Rotations
+    mat4 worldXRotateMatrix = rotate(glm::mat4(1.0f), glm::radians(worldAngleX), glm::vec3(1.0f, 0.0f, 0.0f));
+    mat4 worldYRotateMatrix = rotate(glm::mat4(1.0f), glm::radians(worldAngleY), glm::vec3(0.0f, 1.0f, 0.0f));
+    mat4 worldRotateMatrix = worldXRotateMatrix * worldYRotateMatrix;
+    scene.worldRotateMatrix = worldRotateMatrix;
+
+    // grid rotations
+    scene.gridMatrixList = apply_transform_2_model(scene.og_gridMatrixList, worldRotateMatrix);
+
+    // axis rotations
+    scene.yAxisMatrix = worldRotateMatrix * scene.og_yAxisMatrix;
+    scene.xAxisMatrix = worldRotateMatrix * scene.og_xAxisMatrix;
+    scene.zAxisMatrix = worldRotateMatrix * scene.og_zAxisMatrix;
+
+    // model letter/id rotations & specific transformations for focused model
+    std::vector< LetterIDModel >& list_letter_id = scene.list_letter_id;
+    for(size_t i = 0; i < list_letter_id.size(); i++){
+        const LetterIDModel& model = list_letter_id[i];
+        vec3 center = (model.mesh != nullptr) ? (model.mesh->boundsMin + model.mesh->boundsMax) * 0.5f : vec3(0.0f);
+        float modelScale = model.scale * model.pulseScale;
+
+        // rotate and scale in place : around the center of the letters, in model space
+        mat4 scaleMatrix = scale(mat4(1.0f), vec3(modelScale, modelScale, modelScale));
+        mat4 rotateMatrix = rotate(glm::mat4(1.0f), glm::radians(model.angle + model.spinAngle), glm::vec3(0.0f, 1.0f, 0.0f));
+        mat4 inPlaceMatrix = translate(mat4(1.0f), center) * rotateMatrix * scaleMatrix * translate(mat4(1.0f), -center);
+
+        // orbit around the ring center
+        mat4 orbitMatrix = rotate(glm::mat4(1.0f), glm::radians(model.orbitAngle), glm::vec3(0.0f, 1.0f, 0.0f));
+        mat4 moveMatrix = translate(mat4(1.0f), vec3(model.x, model.y, model.z));
+
+        list_letter_id[i].m_model_matrix = worldRotateMatrix * moveMatrix * orbitMatrix * model.og_model_matrix * inPlaceMatrix;
+    }
+}
+
+vec3 letter_id_center(const LetterIDModel& model){
+    vec3 localCenter = (model.mesh->boundsMin + model.mesh->boundsMax) * 0.5f;
+    vec4 center = model.m_model_matrix * vec4(localCenter, 1.0f);
+    return vec3(center.x, center.y, center.z);
+}
+
+void draw_scene(const Scene& scene, RenderBackend& backend, const std::vector< bool >* visibleModels){
+    // Draw Grid
+    backend.bind_cube(false, vec3(1.0f, 1.0f, 1.0f));
+    draw_model(scene.gridMatrixList, backend);
+
+    // Draw Axis
+    backend.bind_cube(false, vec3(0.0f, 1.0f, 0.0f));
+    draw_matrix(scene.yAxisMatrix, backend);
+
+    backend.bind_cube(false, vec3(1.0f, 0.0f, 0.0f));
+    draw_matrix(scene.xAxisMatrix, backend);
+
+    backend.bind_cube(false, vec3(0.0f, 0.0f, 1.0f));
+    draw_matrix(scene.zAxisMatrix, backend);
+
+    //// Draw the Letter/ID list (one draw call per model)
+    for(size_t i = 0; i < scene.list_letter_id.size(); i++){
+        if(visibleModels != NULL && !(*visibleModels)[i]){
+            continue;
+        }
+        backend.draw_mesh(*scene.list_letter_id[i].mesh, scene.list_letter_id[i].m_model_matrix);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "models.h"
+#include "glyph_cache.h"
+#include "render_backend.h"
+
+// Everything that is built before the main loop. Only CPU work : it can be built on a worker thread
+// while the window and GL context are created, the GPU upload is done afterwards (glyphCache.upload()).
+struct Scene {
+    float gridUnit = 0.2f;
+    int gridSize = 128;
+    int circleDistance = 50; // radius of the ring of models, in grid units
+
+    std::vector< glm::mat4 > og_gridMatrixList;
+
+    glm::mat4 og_yAxisMatrix;
+    glm::mat4 og_xAxisMatrix;
+    glm::mat4 og_zAxisMatrix;
+
+    GlyphCache glyphCache; // owns the meshes the models point to -> the scene must not be copied
+    std::vector< LetterIDModel > list_letter_id;
+
+    // updated every frame by update_scene()
+    glm::mat4 worldRotateMatrix;
+    std::vector< glm::mat4 > gridMatrixList;
+    glm::mat4 yAxisMatrix;
+    glm::mat4 xAxisMatrix;
+    glm::mat4 zAxisMatrix;
+
+    Scene() {}
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+};
+
+// lines of the grid on the xz plane
+std::vector< glm::mat4 > build_grid_model(int gridSize, float gridUnit);
+
+// build the grid, the axis and the letter/id models
+void build_scene(Scene& scene);
+
+// add count small copies of the first letter/id model around the ring (24 per layer, stacked up),
+// facing the center. Returns the index of the first one
+int add_ring_models(Scene& scene, int count);
+
+// apply the world rotation (arrow keys) and the input transforms of each model :
+// move, orbit around the ring center, then rotation and scale in place around the model center
+void update_scene(Scene& scene, float worldAngleX, float worldAngleY);
+
+// world position of the center of the model letters (after update_scene())
+glm::vec3 letter_id_center(const LetterIDModel& model);
+
+// draw the grid, the axis and the letter/id models (view, projection and render mode are set by the caller)
+// visibleModels : one flag per letter/id model (culling), NULL -> draw them all
+void draw_scene(const Scene& scene, RenderBackend& backend, const std::vector< bool >* visibleModels = NULL);
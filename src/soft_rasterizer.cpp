@@ -0,0 +1,591 @@
+#include "soft_rasterizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#include "models.h"
+#include "glyph_cache.h"
+
+using namespace glm;
+
+static double ms_since(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// pixel index of a window coordinate, clamped so huge coordinates (vertices close to the near plane) can't overflow
+static int pixel_floor(float v){
+    return (int)std::floor(std::max(-1.0e8f, std::min(1.0e8f, v)));
+}
+
+static uint32_t pack_color(vec3 color){
+    uint32_t r = (uint32_t)(std::max(0.0f, std::min(1.0f, color.x)) * 255.0f + 0.5f);
+    uint32_t g = (uint32_t)(std::max(0.0f, std::min(1.0f, color.y)) * 255.0f + 0.5f);
+    uint32_t b = (uint32_t)(std::max(0.0f, std::min(1.0f, color.z)) * 255.0f + 0.5f);
+    return r | (g << 8) | (b << 16) | (255u << 24);
+}
+
+// edge function : > 0 if p is on the left of a->b (counter clockwise side, y up)
+static float edge(float ax, float ay, float bx, float by, float px, float py){
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+// viewport transform of a clip space vertex (w > 0)
+static void to_screen(const vec4& clip, const vec3& color, const int viewport[4], float& x, float& y, float& z, float& invW, vec3& colorOverW){
+    invW = 1.0f / clip.w;
+    x = viewport[0] + (clip.x * invW * 0.5f + 0.5f) * viewport[2];
+    y = viewport[1] + (clip.y * invW * 0.5f + 0.5f) * viewport[3];
+    z = clip.z * invW * 0.5f + 0.5f;
+    colorOverW = color * invW;
+}
+
+// top-left fill rule (counter clockwise, y up) : a pixel center exactly on a shared edge is drawn by one triangle only
+static bool is_top_left(float ax, float ay, float bx, float by){
+    float dx = bx - ax;
+    float dy = by - ay;
+    return dy < 0.0f || (dy == 0.0f && dx < 0.0f);
+}
+
+SoftwareRasterizer::SoftwareRasterizer(int width, int height, int numThreads){
+    m_width = width;
+    m_height = height;
+    m_numThreads = numThreads > 0 ? numThreads : std::max(1, (int)std::thread::hardware_concurrency());
+    m_tilesX = (width + tileSize - 1) / tileSize;
+    m_tilesY = (height + tileSize - 1) / tileSize;
+
+    m_color.assign(width * height, pack_color(vec3(0.0f)));
+    m_depth.assign(width * height, 1.0f);
+
+    m_viewProjection = mat4(1.0f);
+    m_mode = RENDER_FILL;
+    set_viewport(0, 0, width, height);
+    m_boundCube = NULL;
+
+    m_threadPrimitives.resize(m_numThreads);
+    m_tileBins.resize(m_tilesX * m_tilesY);
+    m_workers.start(m_numThreads);
+}
+
+// ### STATE ###
+
+void SoftwareRasterizer::begin_frame(){
+    std::fill(m_color.begin(), m_color.end(), pack_color(vec3(0.0f))); // glClearColor(0, 0, 0, 1)
+    std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+    m_commands.clear();
+}
+
+void SoftwareRasterizer::set_view_projection(const mat4& viewMatrix, const mat4& projectionMatrix){
+    m_viewProjection = projectionMatrix * viewMatrix;
+}
+
+void SoftwareRasterizer::set_render_mode(RenderMode mode){
+    m_mode = mode;
+}
+
+void SoftwareRasterizer::set_viewport(int x, int y, int width, int height){
+    // keep it inside the framebuffer, the bounding boxes are clamped to it (acts as the scissor)
+    m_viewport[0] = std::max(0, std::min(m_width, x));
+    m_viewport[1] = std::max(0, std::min(m_height, y));
+    m_viewport[2] = std::max(0, std::min(m_width - m_viewport[0], width));
+    m_viewport[3] = std::max(0, std::min(m_height - m_viewport[1], height));
+}
+
+void SoftwareRasterizer::bind_cube(bool multiColorFlag, vec3 colorVect){
+    std::tuple< bool, float, float, float > key(multiColorFlag, colorVect.x, colorVect.y, colorVect.z);
+
+    CubeArrays& cube = m_cubes[key];
+    if(cube.vertices.empty()){
+        cube.vertices.resize(72);
+        cube_vertex_array(multiColorFlag, colorVect, cube.vertices.data());
+        cube_corner_array(multiColorFlag, colorVect, cube.corners);
+    }
+
+    m_boundCube = &cube;
+}
+
+void SoftwareRasterizer::draw_cube(const mat4& worldMatrix){
+    if(m_boundCube == NULL){
+        return;
+    }
+
+    DrawCommand command = {m_boundCube->vertices.data(), 36, NULL, 0, m_viewProjection * worldMatrix, m_mode, {m_viewport[0], m_viewport[1], m_viewport[2], m_viewport[3]}};
+    if(m_mode != RENDER_FILL){
+        command.vertices = m_boundCube->corners;
+        command.vertexCount = 8;
+        command.indices = cubeEdgeIndices;
+        command.indexCount = 24;
+    }
+    m_commands.push_back(command);
+}
+
+void SoftwareRasterizer::draw_mesh(const GlyphMesh& mesh, const mat4& worldMatrix){
+    DrawCommand command = {mesh.vertices.data(), mesh.vertexCount, NULL, 0, m_viewProjection * worldMatrix, m_mode, {m_viewport[0], m_viewport[1], m_viewport[2], m_viewport[3]}};
+    if(m_mode != RENDER_FILL){
+        command.vertices = mesh.corners.data();
+        command.vertexCount = mesh.cornerCount;
+        command.indices = mesh.edgeIndices.data();
+        command.indexCount = mesh.edgeIndexCount;
+    }
+    m_commands.push_back(command);
+}
+
+// ### VERTEX STAGE ###
+
+// clip the triangle against the near plane (z >= -w), then viewport transform and back-face culling
+int SoftwareRasterizer::setup_triangle(const vec4 clip[3], const vec3 color[3], const DrawCommand& command, std::vector< ScreenPrimitive >& primitives) const{
+    vec4 polygonClip[4];
+    vec3 polygonColor[4];
+    int polygonSize = 0;
+
+    for(int i = 0; i < 3; i++){
+        const vec4& a = clip[i];
+        const vec4& b = clip[(i + 1) % 3];
+        float da = a.z + a.w;
+        float db = b.z + b.w;
+
+        if(da >= 0.0f){
+            polygonClip[polygonSize] = a;
+            polygonColor[polygonSize] = color[i];
+            polygonSize++;
+        }
+        if((da >= 0.0f) != (db >= 0.0f)){
+            float t = da / (da - db);
+            polygonClip[polygonSize] = a + (b - a) * t;
+            polygonColor[polygonSize] = mix(color[i], color[(i + 1) % 3], t);
+            polygonSize++;
+        }
+    }
+
+    if(polygonSize < 3){
+        return 0;
+    }
+
+    const int* viewport = command.viewport;
+
+    ScreenVertex screen[4];
+    for(int i = 0; i < polygonSize; i++){
+        to_screen(polygonClip[i], polygonColor[i], viewport, screen[i].x, screen[i].y, screen[i].z, screen[i].invW, screen[i].colorOverW);
+    }
+
+    int emitted = 0;
+    for(int i = 1; i + 1 < polygonSize; i++){
+        ScreenPrimitive tri;
+        tri.v[0] = screen[0];
+        tri.v[1] = screen[i];
+        tri.v[2] = screen[i + 1];
+        tri.mode = command.mode;
+
+        // GL_CULL_FACE with the default GL_BACK / GL_CCW
+        float area = edge(tri.v[0].x, tri.v[0].y, tri.v[1].x, tri.v[1].y, tri.v[2].x, tri.v[2].y);
+        if(area <= 0.0f){
+            continue;
+        }
+
+        float minX = std::min(tri.v[0].x, std::min(tri.v[1].x, tri.v[2].x));
+        float maxX = std::max(tri.v[0].x, std::max(tri.v[1].x, tri.v[2].x));
+        float minY = std::min(tri.v[0].y, std::min(tri.v[1].y, tri.v[2].y));
+        float maxY = std::max(tri.v[0].y, std::max(tri.v[1].y, tri.v[2].y));
+
+        tri.minX = std::max(viewport[0], pixel_floor(minX));
+        tri.minY = std::max(viewport[1], pixel_floor(minY));
+        tri.maxX = std::min(viewport[0] + viewport[2] - 1, pixel_floor(maxX));
+        tri.maxY = std::min(viewport[1] + viewport[3] - 1, pixel_floor(maxY));
+
+        if(tri.minX > tri.maxX || tri.minY > tri.maxY){
+            continue; // off screen
+        }
+
+        primitives.push_back(tri);
+        emitted++;
+    }
+
+    return emitted;
+}
+
+// clip the line against the near plane, then viewport transform (lines are never culled)
+int SoftwareRasterizer::setup_line(const vec4 clip[2], const vec3 color[2], const DrawCommand& command, std::vector< ScreenPrimitive >& primitives) const{
+    float da = clip[0].z + clip[0].w;
+    float db = clip[1].z + clip[1].w;
+    if(da < 0.0f && db < 0.0f){
+        return 0;
+    }
+
+    vec4 lineClip[2] = {clip[0], clip[1]};
+    vec3 lineColor[2] = {color[0], color[1]};
+    if(da < 0.0f || db < 0.0f){
+        float t = da / (da - db);
+        int behind = (da < 0.0f) ? 0 : 1;
+        lineClip[behind] = clip[0] + (clip[1] - clip[0]) * t;
+        lineColor[behind] = mix(color[0], color[1], t);
+    }
+
+    const int* viewport = command.viewport;
+
+    ScreenPrimitive line;
+    line.mode = RENDER_LINES;
+    for(int i = 0; i < 2; i++){
+        to_screen(lineClip[i], lineColor[i], viewport, line.v[i].x, line.v[i].y, line.v[i].z, line.v[i].invW, line.v[i].colorOverW);
+    }
+    line.v[2] = line.v[1];
+
+    line.minX = std::max(viewport[0], pixel_floor(std::min(line.v[0].x, line.v[1].x)));
+    line.minY = std::max(viewport[1], pixel_floor(std::min(line.v[0].y, line.v[1].y)));
+    line.maxX = std::min(viewport[0] + viewport[2] - 1, pixel_floor(std::max(line.v[0].x, line.v[1].x)));
+    line.maxY = std::min(viewport[1] + viewport[3] - 1, pixel_floor(std::max(line.v[0].y, line.v[1].y)));
+
+    if(line.minX > line.maxX || line.minY > line.maxY){
+        return 0; // off screen
+    }
+
+    primitives.push_back(line);
+    return 1;
+}
+
+int SoftwareRasterizer::setup_point(const vec4& clip, const vec3& color, const DrawCommand& command, std::vector< ScreenPrimitive >& primitives) const{
+    if(clip.w <= 0.0f || clip.z + clip.w < 0.0f){
+        return 0;
+    }
+
+    const int* viewport = command.viewport;
+
+    ScreenPrimitive point;
+    point.mode = RENDER_POINTS;
+    to_screen(clip, color, viewport, point.v[0].x, point.v[0].y, point.v[0].z, point.v[0].invW, point.v[0].colorOverW);
+    point.v[1] = point.v[0];
+    point.v[2] = point.v[0];
+
+    point.minX = point.maxX = pixel_floor(point.v[0].x);
+    point.minY = point.maxY = pixel_floor(point.v[0].y);
+
+    if(point.minX < viewport[0] || point.minX >= viewport[0] + viewport[2] || point.minY < viewport[1] || point.minY >= viewport[1] + viewport[3]){
+        return 0; // off screen
+    }
+
+    primitives.push_back(point);
+    return 1;
+}
+
+// triangles, lines or points submitted by the draw
+static long long primitive_count(RenderMode mode, int vertexCount, int indexCount){
+    if(mode == RENDER_FILL){
+        return vertexCount / 3;
+    }
+    return (mode == RENDER_LINES) ? indexCount / 2 : vertexCount;
+}
+
+void SoftwareRasterizer::vertex_stage(size_t firstCommand, size_t lastCommand, std::vector< ScreenPrimitive >& primitives, long long& culled) const{
+    for(size_t c = firstCommand; c < lastCommand; c++){
+        const DrawCommand& command = m_commands[c];
+
+        if(command.mode == RENDER_LINES){
+            for(int i = 0; i + 1 < command.indexCount; i += 2){
+                vec4 clip[2];
+                vec3 color[2];
+                for(int k = 0; k < 2; k++){
+                    unsigned int index = command.indices[i + k];
+                    clip[k] = command.modelViewProjection * vec4(command.vertices[index * 2], 1.0f);
+                    color[k] = command.vertices[index * 2 + 1];
+                }
+
+                if(setup_line(clip, color, command, primitives) == 0){
+                    culled++;
+                }
+            }
+            continue;
+        }
+
+        if(command.mode == RENDER_POINTS){
+            for(int i = 0; i < command.vertexCount; i++){
+                vec4 clip = command.modelViewProjection * vec4(command.vertices[i * 2], 1.0f);
+                if(setup_point(clip, command.vertices[i * 2 + 1], command, primitives) == 0){
+                    culled++;
+                }
+            }
+            continue;
+        }
+
+        for(int i = 0; i + 2 < command.vertexCount; i += 3){
+            vec4 clip[3];
+            vec3 color[3];
+            for(int k = 0; k < 3; k++){
+                clip[k] = command.modelViewProjection * vec4(command.vertices[(i + k) * 2], 1.0f);
+                color[k] = command.vertices[(i + k) * 2 + 1];
+            }
+
+            if(setup_triangle(clip, color, command, primitives) == 0){
+                culled++;
+            }
+        }
+    }
+}
+
+// ### TILE STAGE ###
+
+bool SoftwareRasterizer::depth_test_and_write(int x, int y, float depth, vec3 color){
+    // GL_LESS, and the far plane
+    int index = y * m_width + x;
+    if(depth < 0.0f || depth > 1.0f || depth >= m_depth[index]){
+        return false;
+    }
+
+    m_depth[index] = depth;
+    m_color[index] = pack_color(color);
+    return true;
+}
+
+void SoftwareRasterizer::raster_fill(const ScreenPrimitive& tri, int x0, int y0, int x1, int y1, long long& pixelsWritten){
+    const ScreenVertex& v0 = tri.v[0];
+    const ScreenVertex& v1 = tri.v[1];
+    const ScreenVertex& v2 = tri.v[2];
+
+    float invArea = 1.0f / edge(v0.x, v0.y, v1.x, v1.y, v2.x, v2.y);
+
+    bool topLeft0 = is_top_left(v1.x, v1.y, v2.x, v2.y);
+    bool topLeft1 = is_top_left(v2.x, v2.y, v0.x, v0.y);
+    bool topLeft2 = is_top_left(v0.x, v0.y, v1.x, v1.y);
+
+    for(int y = y0; y <= y1; y++){
+        float py = y + 0.5f;
+
+        // span of the row inside the 3 edges (long thin triangles have a huge bounding box), 1 pixel of margin,
+        // the exact test below still decides every pixel
+        float spanMin = (float)x0;
+        float spanMax = (float)x1 + 1.0f;
+        for(int k = 0; k < 3; k++){
+            const ScreenVertex& a = tri.v[(k + 1) % 3];
+            const ScreenVertex& b = tri.v[(k + 2) % 3];
+            float dy = b.y - a.y;
+            float c = (b.x - a.x) * (py - a.y);
+
+            if(dy > 0.0f){
+                spanMax = std::min(spanMax, a.x + c / dy);
+            }
+            else if(dy < 0.0f){
+                spanMin = std::max(spanMin, a.x + c / dy);
+            }
+        }
+
+        int rowX0 = std::max(x0, pixel_floor(spanMin - 0.5f) - 1);
+        int rowX1 = std::min(x1, pixel_floor(spanMax - 0.5f) + 1);
+
+        for(int x = rowX0; x <= rowX1; x++){
+            float px = x + 0.5f;
+
+            float w0 = edge(v1.x, v1.y, v2.x, v2.y, px, py);
+            float w1 = edge(v2.x, v2.y, v0.x, v0.y, px, py);
+            float w2 = edge(v0.x, v0.y, v1.x, v1.y, px, py);
+
+            if((w0 < 0.0f || (w0 == 0.0f && !topLeft0)) ||
+               (w1 < 0.0f || (w1 == 0.0f && !topLeft1)) ||
+               (w2 < 0.0f || (w2 == 0.0f && !topLeft2))){
+                continue;
+            }
+
+            w0 *= invArea;
+            w1 *= invArea;
+            w2 *= invArea;
+
+            float depth = w0 * v0.z + w1 * v1.z + w2 * v2.z;
+
+            // perspective correct color (same as the smooth "vertexColor" varying)
+            float invW = w0 * v0.invW + w1 * v1.invW + w2 * v2.invW;
+            vec3 color = (v0.colorOverW * w0 + v1.colorOverW * w1 + v2.colorOverW * w2) * (1.0f / invW);
+
+            if(depth_test_and_write(x, y, depth, color)){
+                pixelsWritten++;
+            }
+        }
+    }
+}
+
+void SoftwareRasterizer::raster_line(const ScreenVertex& a, const ScreenVertex& b, int x0, int y0, int x1, int y1, long long& pixelsWritten){
+    // Liang-Barsky clipping of the segment to the tile
+    float dx = b.x - a.x;
+    float dy = b.y - a.y;
+    float p[4] = {-dx, dx, -dy, dy};
+    float q[4] = {a.x - x0, (x1 + 1.0f) - a.x, a.y - y0, (y1 + 1.0f) - a.y};
+    float t0 = 0.0f;
+    float t1 = 1.0f;
+
+    for(int i = 0; i < 4; i++){
+        if(p[i] == 0.0f){
+            if(q[i] < 0.0f){
+                return;
+            }
+            continue;
+        }
+
+        float t = q[i] / p[i];
+        if(p[i] < 0.0f){
+            t0 = std::max(t0, t);
+        }
+        else{
+            t1 = std::min(t1, t);
+        }
+    }
+
+    if(t0 > t1){
+        return;
+    }
+
+    // one sample per pixel along the major axis
+    int steps = std::max(1, (int)std::ceil(std::max(std::fabs(dx), std::fabs(dy)) * (t1 - t0)));
+    for(int i = 0; i <= steps; i++){
+        float t = t0 + (t1 - t0) * i / steps;
+
+        int x = std::min(x1, std::max(x0, pixel_floor(a.x + dx * t)));
+        int y = std::min(y1, std::max(y0, pixel_floor(a.y + dy * t)));
+
+        float depth = a.z + (b.z - a.z) * t;
+        float invW = a.invW + (b.invW - a.invW) * t;
+        vec3 color = mix(a.colorOverW, b.colorOverW, t) * (1.0f / invW);
+
+        if(depth_test_and_write(x, y, depth, color)){
+            pixelsWritten++;
+        }
+    }
+}
+
+void SoftwareRasterizer::raster_point(const ScreenVertex& a, int x0, int y0, int x1, int y1, long long& pixelsWritten){
+    int x = pixel_floor(a.x);
+    int y = pixel_floor(a.y);
+    if(x < x0 || x > x1 || y < y0 || y > y1){
+        return;
+    }
+
+    if(depth_test_and_write(x, y, a.z, a.colorOverW * (1.0f / a.invW))){
+        pixelsWritten++;
+    }
+}
+
+void SoftwareRasterizer::raster_tile(int tile, long long& pixelsWritten){
+    int tileX0 = (tile % m_tilesX) * tileSize;
+    int tileY0 = (tile / m_tilesX) * tileSize;
+    int tileX1 = std::min(tileX0 + tileSize, m_width) - 1;
+    int tileY1 = std::min(tileY0 + tileSize, m_height) - 1;
+
+    const std::vector< const ScreenPrimitive* >& bin = m_tileBins[tile];
+    for(size_t i = 0; i < bin.size(); i++){
+        const ScreenPrimitive& primitive = *bin[i];
+
+        // the bounding box is clamped to the viewport -> nothing is drawn outside of it
+        int x0 = std::max(tileX0, primitive.minX);
+        int y0 = std::max(tileY0, primitive.minY);
+        int x1 = std::min(tileX1, primitive.maxX);
+        int y1 = std::min(tileY1, primitive.maxY);
+
+        if(primitive.mode == RENDER_FILL){
+            raster_fill(primitive, x0, y0, x1, y1, pixelsWritten);
+        }
+        else if(primitive.mode == RENDER_LINES){
+            raster_line(primitive.v[0], primitive.v[1], x0, y0, x1, y1, pixelsWritten);
+        }
+        else{
+            raster_point(primitive.v[0], x0, y0, x1, y1, pixelsWritten);
+        }
+    }
+}
+
+// ### FRAME ###
+
+void SoftwareRasterizer::end_frame(){
+    m_stats = Stats();
+
+    // 1. vertex stage : contiguous ranges of draws per thread -> the primitive order is the submission order
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::vector< long long > culled(m_numThreads, 0);
+    size_t commandsPerThread = (m_commands.size() + m_numThreads - 1) / m_numThreads;
+
+    m_workers.run([this, &culled, commandsPerThread](int t) {
+        m_threadPrimitives[t].clear();
+        size_t first = std::min(m_commands.size(), t * commandsPerThread);
+        size_t last = std::min(m_commands.size(), first + commandsPerThread);
+        vertex_stage(first, last, m_threadPrimitives[t], culled[t]);
+    });
+
+    for(size_t c = 0; c < m_commands.size(); c++){
+        m_stats.primitivesSubmitted += primitive_count(m_commands[c].mode, m_commands[c].vertexCount, m_commands[c].indexCount);
+    }
+    for(int t = 0; t < m_numThreads; t++){
+        m_stats.primitivesCulled += culled[t];
+        m_stats.primitivesRasterized += m_threadPrimitives[t].size();
+    }
+    m_stats.vertexMs = ms_since(start);
+
+    // 2. binning
+    start = std::chrono::steady_clock::now();
+
+    for(size_t b = 0; b < m_tileBins.size(); b++){
+        m_tileBins[b].clear();
+    }
+    for(int t = 0; t < m_numThreads; t++){
+        const std::vector< ScreenPrimitive >& primitives = m_threadPrimitives[t];
+        for(size_t i = 0; i < primitives.size(); i++){
+            const ScreenPrimitive& primitive = primitives[i];
+            for(int ty = primitive.minY / tileSize; ty <= primitive.maxY / tileSize; ty++){
+                for(int tx = primitive.minX / tileSize; tx <= primitive.maxX / tileSize; tx++){
+                    m_tileBins[ty * m_tilesX + tx].push_back(&primitive);
+                }
+            }
+        }
+    }
+    m_stats.binningMs = ms_since(start);
+
+    // 3. tile stage
+    start = std::chrono::steady_clock::now();
+
+    std::atomic<int> nextTile(0);
+    std::vector< long long > pixelsWritten(m_numThreads, 0);
+    int numTiles = m_tilesX * m_tilesY;
+
+    m_workers.run([this, &nextTile, &pixelsWritten, numTiles](int t) {
+        for(int tile = nextTile++; tile < numTiles; tile = nextTile++){
+            raster_tile(tile, pixelsWritten[t]);
+        }
+    });
+
+    for(int t = 0; t < m_numThreads; t++){
+        m_stats.pixelsWritten += pixelsWritten[t];
+    }
+    m_stats.rasterMs = ms_since(start);
+}
+
+// ### OUTPUT ###
+
+void SoftwareRasterizer::print_stats() const{
+    double totalMs = m_stats.vertexMs + m_stats.binningMs + m_stats.rasterMs;
+    double seconds = std::max(totalMs, 1.0e-6) / 1000.0;
+
+    std::printf("### Software rasterizer (%dx%d, %d threads) ###\n", m_width, m_height, m_numThreads);
+    std::printf("  primitives   : %lld submitted, %lld culled, %lld rasterized\n", m_stats.primitivesSubmitted, m_stats.primitivesCulled, m_stats.primitivesRasterized);
+    std::printf("  pixels       : %lld written\n", m_stats.pixelsWritten);
+    std::printf("  time         : %.3f ms (vertex %.3f, binning %.3f, raster %.3f)\n", totalMs, m_stats.vertexMs, m_stats.binningMs, m_stats.rasterMs);
+    std::printf("  throughput   : %.3f Mprimitives/s, %.3f Mpixels/s\n", m_stats.primitivesSubmitted / seconds / 1.0e6, m_stats.pixelsWritten / seconds / 1.0e6);
+}
+
+bool SoftwareRasterizer::write_ppm(const std::string& path) const{
+    std::ofstream file(path.c_str(), std::ios::binary);
+    if(!file){
+        return false;
+    }
+
+    file << "P6\n" << m_width << " " << m_height << "\n255\n";
+
+    std::vector< unsigned char > row(m_width * 3);
+    for(int y = m_height - 1; y >= 0; y--){
+        for(int x = 0; x < m_width; x++){
+            uint32_t color = m_color[y * m_width + x];
+            row[x * 3 + 0] = color & 0xFF;
+            row[x * 3 + 1] = (color >> 8) & 0xFF;
+            row[x * 3 + 2] = (color >> 16) & 0xFF;
+        }
+        file.write((const char*)row.data(), row.size());
+    }
+
+    return (bool)file;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "render_backend.h"
+#include "worker_pool.h"
+
+// Reference CPU rasterizer (no GPU needed). The draws of a frame are recorded and rasterized in end_frame() :
+//   1. vertex stage  : the draws are split between the threads (transform, near plane clipping, back-face culling)
+//   2. binning       : every primitive is added to the tiles its bounding box touches, in submission order
+//   3. tile stage    : the threads take the tiles one by one and rasterize their primitives in order
+// Like GLRenderBackend, the point and line modes draw the cube corners / edges instead of the triangles.
+// A pixel always belongs to one tile and its primitives are always processed in the same order,
+// so the image is the same for any number of threads (usable as a reference for image diffs).
+class SoftwareRasterizer : public RenderBackend {
+public:
+    struct Stats {
+        long long primitivesSubmitted = 0;   // triangles, lines or points depending on the render mode
+        long long primitivesCulled = 0;      // back facing, behind the near plane or off screen
+        long long primitivesRasterized = 0;  // after clipping (a clipped triangle can give 2)
+        long long pixelsWritten = 0;        // passed the depth test
+        double vertexMs = 0.0;
+        double binningMs = 0.0;
+        double rasterMs = 0.0;
+    };
+
+    // numThreads = 0 -> one per hardware thread
+    SoftwareRasterizer(int width, int height, int numThreads = 0);
+
+    void begin_frame() override;
+    void end_frame() override;
+
+    void set_view_projection(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) override;
+    void set_render_mode(RenderMode mode) override;
+    void set_viewport(int x, int y, int width, int height) override;
+
+    void bind_cube(bool multiColorFlag, glm::vec3 colorVect) override;
+    void draw_cube(const glm::mat4& worldMatrix) override;
+    void draw_mesh(const GlyphMesh& mesh, const glm::mat4& worldMatrix) override;
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int thread_count() const { return m_numThreads; }
+
+    // RGBA8, row 0 is the bottom row (same as glReadPixels)
+    const std::vector< uint32_t >& color_buffer() const { return m_color; }
+    const std::vector< float >& depth_buffer() const { return m_depth; }
+
+    // stats of the last end_frame()
+    const Stats& stats() const { return m_stats; }
+    void print_stats() const;
+
+    // binary PPM (P6), top row first
+    bool write_ppm(const std::string& path) const;
+
+private:
+    static const int tileSize = 64;
+
+    struct DrawCommand {
+        const glm::vec3* vertices; // position, color (fill : triangles, points / lines : cube corners)
+        int vertexCount;
+        const unsigned int* indices; // lines : pairs of vertex indices
+        int indexCount;
+        glm::mat4 modelViewProjection;
+        RenderMode mode;
+        int viewport[4];
+    };
+
+    // vertex in window coordinates (y up, pixel centers at +0.5)
+    struct ScreenVertex {
+        float x, y, z;   // z = depth [0, 1]
+        float invW;
+        glm::vec3 colorOverW;
+    };
+
+    // triangle, line (v[0], v[1]) or point (v[0])
+    struct ScreenPrimitive {
+        ScreenVertex v[3];
+        int minX, minY, maxX, maxY; // pixel bounding box (clamped to the viewport)
+        RenderMode mode;
+    };
+
+    void vertex_stage(size_t firstCommand, size_t lastCommand, std::vector< ScreenPrimitive >& primitives, long long& culled) const;
+    int setup_triangle(const glm::vec4 clip[3], const glm::vec3 color[3], const DrawCommand& command, std::vector< ScreenPrimitive >& primitives) const;
+    int setup_line(const glm::vec4 clip[2], const glm::vec3 color[2], const DrawCommand& command, std::vector< ScreenPrimitive >& primitives) const;
+    int setup_point(const glm::vec4& clip, const glm::vec3& color, const DrawCommand& command, std::vector< ScreenPrimitive >& primitives) const;
+    void raster_tile(int tile, long long& pixelsWritten);
+
+    bool depth_test_and_write(int x, int y, float depth, glm::vec3 color);
+    void raster_fill(const ScreenPrimitive& tri, int x0, int y0, int x1, int y1, long long& pixelsWritten);
+    void raster_line(const ScreenVertex& a, const ScreenVertex& b, int x0, int y0, int x1, int y1, long long& pixelsWritten);
+    void raster_point(const ScreenVertex& a, int x0, int y0, int x1, int y1, long long& pixelsWritten);
+
+    int m_width;
+    int m_height;
+    int m_numThreads;
+    WorkerPool m_workers; // started once, runs the vertex and tile stages of every frame
+    int m_tilesX;
+    int m_tilesY;
+
+    std::vector< uint32_t > m_color;
+    std::vector< float > m_depth;
+
+    glm::mat4 m_viewProjection;
+    RenderMode m_mode;
+    int m_viewport[4];
+
+    struct CubeArrays {
+        std::vector< glm::vec3 > vertices; // cube_vertex_array
+        glm::vec3 corners[16];             // cube_corner_array
+    };
+
+    std::map< std::tuple< bool, float, float, float >, CubeArrays > m_cubes;
+    const CubeArrays* m_boundCube;
+
+    std::vector< DrawCommand > m_commands;
+    std::vector< std::vector< ScreenPrimitive > > m_threadPrimitives;
+    std::vector< std::vector< const ScreenPrimitive* > > m_tileBins;
+
+    Stats m_stats;
+};
@@ -0,0 +1,34 @@
+#include "startup_stats.h"
+
+#include <cstdio>
+
+static double ms_between(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to){
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+StartupStats::StartupStats(){
+    m_start = std::chrono::steady_clock::now();
+    m_last = m_start;
+}
+
+void StartupStats::mark(const std::string& phase){
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    m_phases.push_back({phase, ms_between(m_last, now), false});
+    m_last = now;
+}
+
+void StartupStats::add(const std::string& phase, double ms){
+    m_phases.push_back({phase, ms, true});
+}
+
+double StartupStats::elapsed_ms() const{
+    return ms_between(m_start, std::chrono::steady_clock::now());
+}
+
+void StartupStats::print() const{
+    std::printf("### Startup ###\n");
+    for(size_t i = 0; i < m_phases.size(); i++){
+        std::printf("  %-28s %9.3f ms%s\n", m_phases[i].name.c_str(), m_phases[i].ms, m_phases[i].overlapped ? "  (worker thread, overlapped)" : "");
+    }
+    std::printf("  %-28s %9.3f ms\n", "time to first frame", ms_between(m_start, m_last));
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Time spent in each startup phase, printed with --startup-stats
+class StartupStats {
+public:
+    StartupStats();
+
+    // end the current phase (started at the previous mark) and record it under the given name
+    void mark(const std::string& phase);
+
+    // record a phase that was measured elsewhere (ex: on the worker thread), not part of the sequential total
+    void add(const std::string& phase, double ms);
+
+    // milliseconds since construction
+    double elapsed_ms() const;
+
+    void print() const;
+
+private:
+    struct Phase {
+        std::string name;
+        double ms;
+        bool overlapped;
+    };
+
+    std::chrono::steady_clock::time_point m_start;
+    std::chrono::steady_clock::time_point m_last;
+    std::vector< Phase > m_phases;
+};
@@ -0,0 +1,496 @@
+#include "telemetry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <unistd.h>
+#else
+#include <unistd.h>
+#endif
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#endif
+
+// ### HEAP ###
+
+// constant initialized : usable by the allocations done before main()
+static std::atomic< long long > g_heapAllocations(0);
+static std::atomic< long long > g_heapBytesAllocated(0);
+static std::atomic< long long > g_heapBytesFreed(0);
+
+// the counting operator new / delete are only built with TELEMETRY_HEAP_HOOKS (set for ass1, not for the
+// benchmarks : they would time the counting too), the counters stay at 0 without them
+#ifdef TELEMETRY_HEAP_HOOKS
+static const bool heapTracked = true;
+
+// the size is stored in front of each block (keeps the default new alignment)
+static const size_t heapHeaderSize = alignof(std::max_align_t);
+
+static void* counted_alloc(size_t size){
+    char* block = static_cast< char* >(std::malloc(size + heapHeaderSize));
+    if(block == nullptr){
+        return nullptr;
+    }
+    *reinterpret_cast< size_t* >(block) = size;
+
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    g_heapBytesAllocated.fetch_add((long long)size, std::memory_order_relaxed);
+    return block + heapHeaderSize;
+}
+
+static void counted_free(void* pointer){
+    if(pointer == nullptr){
+        return;
+    }
+    char* block = static_cast< char* >(pointer) - heapHeaderSize;
+    g_heapBytesFreed.fetch_add((long long)*reinterpret_cast< size_t* >(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+static void* counted_new(size_t size){
+    void* pointer = counted_alloc(size > 0 ? size : 1);
+    if(pointer == nullptr){
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+// the over aligned versions (std::align_val_t) keep their default implementation, they are not counted
+void* operator new(std::size_t size) { return counted_new(size); }
+void* operator new[](std::size_t size) { return counted_new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size > 0 ? size : 1); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size > 0 ? size : 1); }
+
+void operator delete(void* pointer) noexcept { counted_free(pointer); }
+void operator delete[](void* pointer) noexcept { counted_free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { counted_free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { counted_free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { counted_free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { counted_free(pointer); }
+#else
+static const bool heapTracked = false;
+#endif
+
+// ### GL OBJECTS ###
+
+// only touched by the thread of the GL context
+static long long g_liveGLObjects[GL_OBJECT_TYPE_COUNT] = {};
+static std::map< GLuint, long long > g_bufferSizes;
+static long long g_gpuBufferBytes = 0;
+static long long g_uploadedBytesTotal = 0;
+
+static void objects_created(GLObjectType type, GLsizei count, const GLuint* names){
+    for(GLsizei i = 0; i < count; i++){
+        if(names[i] != 0){
+            g_liveGLObjects[type]++;
+        }
+    }
+}
+
+static void objects_deleted(GLObjectType type, GLsizei count, const GLuint* names){
+    // deleting 0 is ignored by GL
+    for(GLsizei i = 0; i < count; i++){
+        if(names[i] != 0){
+            g_liveGLObjects[type]--;
+        }
+    }
+}
+
+void tracked_gen_buffers(GLsizei count, GLuint* buffers){
+    glGenBuffers(count, buffers);
+    objects_created(GL_OBJECT_BUFFER, count, buffers);
+}
+
+void tracked_delete_buffers(GLsizei count, const GLuint* buffers){
+    objects_deleted(GL_OBJECT_BUFFER, count, buffers);
+    for(GLsizei i = 0; i < count; i++){
+        std::map< GLuint, long long >::iterator found = g_bufferSizes.find(buffers[i]);
+        if(found != g_bufferSizes.end()){
+            g_gpuBufferBytes -= found->second;
+            g_bufferSizes.erase(found);
+        }
+    }
+    glDeleteBuffers(count, buffers);
+}
+
+void tracked_gen_vertex_arrays(GLsizei count, GLuint* arrays){
+    glGenVertexArrays(count, arrays);
+    objects_created(GL_OBJECT_VERTEX_ARRAY, count, arrays);
+}
+
+void tracked_delete_vertex_arrays(GLsizei count, const GLuint* arrays){
+    objects_deleted(GL_OBJECT_VERTEX_ARRAY, count, arrays);
+    glDeleteVertexArrays(count, arrays);
+}
+
+GLuint tracked_create_shader(GLenum type){
+    GLuint shader = glCreateShader(type);
+    objects_created(GL_OBJECT_SHADER, 1, &shader);
+    return shader;
+}
+
+void tracked_delete_shader(GLuint shader){
+    objects_deleted(GL_OBJECT_SHADER, 1, &shader);
+    glDeleteShader(shader);
+}
+
+GLuint tracked_create_program(){
+    GLuint program = glCreateProgram();
+    objects_created(GL_OBJECT_PROGRAM, 1, &program);
+    return program;
+}
+
+void tracked_delete_program(GLuint program){
+    objects_deleted(GL_OBJECT_PROGRAM, 1, &program);
+    glDeleteProgram(program);
+}
+
+void tracked_buffer_data(GLenum target, GLuint buffer, GLsizeiptr size, const void* data, GLenum usage){
+    glBufferData(target, size, data, usage);
+
+    // glBufferData replaces the whole storage of the buffer
+    long long& bufferSize = g_bufferSizes[buffer];
+    g_gpuBufferBytes += (long long)size - bufferSize;
+    bufferSize = (long long)size;
+
+    if(data != nullptr){
+        g_uploadedBytesTotal += (long long)size;
+    }
+}
+
+const char* gl_object_type_name(GLObjectType type){
+    static const char* names[GL_OBJECT_TYPE_COUNT] = { "buffer", "vertex_array", "shader", "program" };
+    return names[type];
+}
+
+// ### FRAMES ###
+
+static std::mutex g_snapshotMutex;
+static TelemetrySnapshot g_snapshot;
+
+// totals at the end of the previous frame
+static long long g_lastUploadedBytes = 0;
+static long long g_lastHeapAllocations = 0;
+static long long g_lastHeapBytes = 0;
+
+void telemetry_end_frame(){
+    long long heapAllocations = g_heapAllocations.load(std::memory_order_relaxed);
+    long long heapBytesAllocated = g_heapBytesAllocated.load(std::memory_order_relaxed);
+    long long heapBytesFreed = g_heapBytesFreed.load(std::memory_order_relaxed);
+
+    std::lock_guard< std::mutex > lock(g_snapshotMutex);
+    TelemetrySnapshot& snapshot = g_snapshot;
+
+    snapshot.frame++;
+    for(int type = 0; type < GL_OBJECT_TYPE_COUNT; type++){
+        snapshot.liveGLObjects[type] = g_liveGLObjects[type];
+    }
+    snapshot.gpuBufferBytes = g_gpuBufferBytes;
+
+    snapshot.uploadedBytesFrame = g_uploadedBytesTotal - g_lastUploadedBytes;
+    snapshot.uploadedBytesTotal = g_uploadedBytesTotal;
+
+    snapshot.heapTracked = heapTracked;
+    snapshot.heapAllocationsFrame = heapAllocations - g_lastHeapAllocations;
+    snapshot.heapAllocationsTotal = heapAllocations;
+    snapshot.heapBytesFrame = heapBytesAllocated - g_lastHeapBytes;
+    snapshot.liveHeapBytes = heapBytesAllocated - heapBytesFreed;
+
+    snapshot.maxUploadedBytesFrame = std::max(snapshot.maxUploadedBytesFrame, snapshot.uploadedBytesFrame);
+    snapshot.maxHeapAllocationsFrame = std::max(snapshot.maxHeapAllocationsFrame, snapshot.heapAllocationsFrame);
+
+    g_lastUploadedBytes = g_uploadedBytesTotal;
+    g_lastHeapAllocations = heapAllocations;
+    g_lastHeapBytes = heapBytesAllocated;
+}
+
+TelemetrySnapshot telemetry_snapshot(){
+    TelemetrySnapshot snapshot;
+    {
+        std::lock_guard< std::mutex > lock(g_snapshotMutex);
+        snapshot = g_snapshot;
+    }
+    snapshot.residentBytes = resident_set_bytes();
+    return snapshot;
+}
+
+long long resident_set_bytes(){
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))){
+        return (long long)counters.WorkingSetSize;
+    }
+    return -1;
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS){
+        return (long long)info.resident_size;
+    }
+    return -1;
+#else
+    // size and resident pages
+    std::ifstream statm("/proc/self/statm");
+    long long pages = 0;
+    long long residentPages = 0;
+    if(!(statm >> pages >> residentPages)){
+        return -1;
+    }
+    return residentPages * sysconf(_SC_PAGESIZE);
+#endif
+}
+
+void telemetry_print(){
+    TelemetrySnapshot snapshot = telemetry_snapshot();
+
+    std::printf("### Telemetry (frame %lld) ###\n", snapshot.frame);
+    std::printf("  gl objects   : %lld buffers, %lld vertex arrays, %lld shaders, %lld programs\n",
+                snapshot.liveGLObjects[GL_OBJECT_BUFFER], snapshot.liveGLObjects[GL_OBJECT_VERTEX_ARRAY],
+                snapshot.liveGLObjects[GL_OBJECT_SHADER], snapshot.liveGLObjects[GL_OBJECT_PROGRAM]);
+    std::printf("  gpu buffers  : %.1f KB\n", snapshot.gpuBufferBytes / 1024.0);
+    std::printf("  uploads      : %.1f KB last frame (max %.1f KB), %.1f MB in total\n",
+                snapshot.uploadedBytesFrame / 1024.0, snapshot.maxUploadedBytesFrame / 1024.0, snapshot.uploadedBytesTotal / (1024.0 * 1024.0));
+    if(snapshot.heapTracked){
+        std::printf("  heap         : %lld allocations last frame (max %lld, %.1f KB), %.1f MB live\n",
+                    snapshot.heapAllocationsFrame, snapshot.maxHeapAllocationsFrame, snapshot.heapBytesFrame / 1024.0, snapshot.liveHeapBytes / (1024.0 * 1024.0));
+    }
+    if(snapshot.residentBytes >= 0){
+        std::printf("  resident     : %.1f MB\n", snapshot.residentBytes / (1024.0 * 1024.0));
+    }
+
+    // new max period
+    std::lock_guard< std::mutex > lock(g_snapshotMutex);
+    g_snapshot.maxUploadedBytesFrame = 0;
+    g_snapshot.maxHeapAllocationsFrame = 0;
+}
+
+// ### ENDPOINT ###
+
+static void append_metric(std::string& text, const char* name, const char* type, const char* help, long long value){
+    char line[256];
+    std::snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s %s\n%s %lld\n", name, help, name, type, name, value);
+    text += line;
+}
+
+static std::string metrics_text(const TelemetrySnapshot& snapshot){
+    std::string text;
+    append_metric(text, "ass1_frames_total", "counter", "Frames since the start.", snapshot.frame);
+
+    text += "# HELP ass1_gl_objects Live GL objects by type.\n# TYPE ass1_gl_objects gauge\n";
+    for(int type = 0; type < GL_OBJECT_TYPE_COUNT; type++){
+        char line[128];
+        std::snprintf(line, sizeof(line), "ass1_gl_objects{type=\"%s\"} %lld\n", gl_object_type_name((GLObjectType)type), snapshot.liveGLObjects[type]);
+        text += line;
+    }
+
+    append_metric(text, "ass1_gpu_buffer_bytes", "gauge", "Storage of the live GL buffers.", snapshot.gpuBufferBytes);
+    append_metric(text, "ass1_uploaded_bytes_frame", "gauge", "Bytes uploaded with glBufferData during the last frame.", snapshot.uploadedBytesFrame);
+    append_metric(text, "ass1_uploaded_bytes_total", "counter", "Bytes uploaded with glBufferData since the start.", snapshot.uploadedBytesTotal);
+    if(snapshot.heapTracked){
+        append_metric(text, "ass1_heap_allocations_frame", "gauge", "Heap allocations during the last frame.", snapshot.heapAllocationsFrame);
+        append_metric(text, "ass1_heap_allocations_total", "counter", "Heap allocations since the start.", snapshot.heapAllocationsTotal);
+        append_metric(text, "ass1_heap_allocated_bytes_frame", "gauge", "Heap bytes allocated during the last frame.", snapshot.heapBytesFrame);
+        append_metric(text, "ass1_heap_live_bytes", "gauge", "Heap bytes allocated and not freed.", snapshot.liveHeapBytes);
+    }
+    if(snapshot.residentBytes >= 0){
+        append_metric(text, "ass1_resident_bytes", "gauge", "Resident set size of the process.", snapshot.residentBytes);
+    }
+    return text;
+}
+
+#if defined(_WIN32)
+
+bool telemetry_start_server(int port, const std::string& socketPath){
+    if(port > 0 || !socketPath.empty()){
+        std::fprintf(stderr, "The telemetry endpoint is not available on Windows (use --telemetry)\n");
+    }
+    return false;
+}
+
+void telemetry_stop_server(){
+}
+
+#else
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // macOS : SO_NOSIGPIPE is set on the socket instead
+#endif
+
+static std::thread g_serverThread;
+static std::atomic< bool > g_serverRunning(false);
+static int g_listenSockets[2] = { -1, -1 };
+static std::string g_socketPath;
+
+static int listen_tcp(int port){
+    int server = socket(AF_INET, SOCK_STREAM, 0);
+    if(server < 0){
+        return -1;
+    }
+    int reuse = 1;
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    // local scrapers only
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons((unsigned short)port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if(bind(server, (sockaddr*)&address, sizeof(address)) != 0 || listen(server, 4) != 0){
+        close(server);
+        return -1;
+    }
+    return server;
+}
+
+static int listen_unix(const std::string& path){
+    sockaddr_un address = {};
+    if(path.size() >= sizeof(address.sun_path)){
+        return -1;
+    }
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(server < 0){
+        return -1;
+    }
+
+    // left over by a previous run
+    unlink(path.c_str());
+
+    address.sun_family = AF_UNIX;
+    std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", path.c_str());
+    if(bind(server, (sockaddr*)&address, sizeof(address)) != 0 || listen(server, 4) != 0){
+        close(server);
+        return -1;
+    }
+    return server;
+}
+
+static void answer_client(int client){
+#ifdef SO_NOSIGPIPE
+    int noSigPipe = 1;
+    setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+    // the request is not parsed : every path gets the metrics
+    timeval timeout = { 0, 500000 };
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    char request[1024];
+    recv(client, request, sizeof(request), 0);
+
+    std::string body = metrics_text(telemetry_snapshot());
+    char header[256];
+    std::snprintf(header, sizeof(header),
+                  "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %d\r\nConnection: close\r\n\r\n", (int)body.size());
+    std::string response = header + body;
+
+    size_t sent = 0;
+    while(sent < response.size()){
+        ssize_t count = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if(count <= 0){
+            break;
+        }
+        sent += (size_t)count;
+    }
+}
+
+static void serve(){
+    while(g_serverRunning.load()){
+        pollfd fds[2];
+        int count = 0;
+        for(int i = 0; i < 2; i++){
+            if(g_listenSockets[i] >= 0){
+                fds[count].fd = g_listenSockets[i];
+                fds[count].events = POLLIN;
+                fds[count].revents = 0;
+                count++;
+            }
+        }
+
+        // wake up regularly to notice telemetry_stop_server()
+        if(poll(fds, count, 200) <= 0){
+            continue;
+        }
+
+        for(int i = 0; i < count; i++){
+            if(fds[i].revents & POLLIN){
+                int client = accept(fds[i].fd, NULL, NULL);
+                if(client >= 0){
+                    answer_client(client);
+                    close(client);
+                }
+            }
+        }
+    }
+}
+
+bool telemetry_start_server(int port, const std::string& socketPath){
+    if(g_serverRunning.load() || (port <= 0 && socketPath.empty())){
+        return false;
+    }
+
+    bool ok = true;
+    if(port > 0){
+        g_listenSockets[0] = listen_tcp(port);
+        if(g_listenSockets[0] < 0){
+            std::fprintf(stderr, "Telemetry : can't listen on 127.0.0.1:%d\n", port);
+            ok = false;
+        }
+    }
+    if(!socketPath.empty()){
+        g_listenSockets[1] = listen_unix(socketPath);
+        if(g_listenSockets[1] < 0){
+            std::fprintf(stderr, "Telemetry : can't listen on %s\n", socketPath.c_str());
+            ok = false;
+        }
+        else{
+            g_socketPath = socketPath;
+        }
+    }
+
+    if(g_listenSockets[0] < 0 && g_listenSockets[1] < 0){
+        return false;
+    }
+
+    g_serverRunning = true;
+    g_serverThread = std::thread(serve);
+    return ok;
+}
+
+void telemetry_stop_server(){
+    if(!g_serverRunning.load()){
+        return;
+    }
+    g_serverRunning = false;
+    g_serverThread.join();
+
+    for(int i = 0; i < 2; i++){
+        if(g_listenSockets[i] >= 0){
+            close(g_listenSockets[i]);
+            g_listenSockets[i] = -1;
+        }
+    }
+    if(!g_socketPath.empty()){
+        unlink(g_socketPath.c_str());
+        g_socketPath.clear();
+    }
+}
+
+#endif
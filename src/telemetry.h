@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+
+#define GLEW_STATIC 1   // This allows linking with Static Library on Windows, without DLL
+#include <GL/glew.h>    // Include GLEW - OpenGL Extension Wrangler
+
+// Process resource counters, to catch leaks and per frame waste in long runs :
+//   - live GL objects by type and the GPU buffer memory they hold (the GL calls that create / delete
+//     objects or upload buffer data go through the tracked_* functions below)
+//   - bytes uploaded with glBufferData per frame
+//   - heap allocations per frame and live heap bytes (the global operator new / delete are replaced when
+//     built with TELEMETRY_HEAP_HOOKS)
+//   - resident set size of the process
+// telemetry_end_frame() publishes a snapshot once per frame, which is what the dump and the endpoint read.
+
+enum GLObjectType {
+    GL_OBJECT_BUFFER,
+    GL_OBJECT_VERTEX_ARRAY,
+    GL_OBJECT_SHADER,
+    GL_OBJECT_PROGRAM,
+    GL_OBJECT_TYPE_COUNT
+};
+
+struct TelemetrySnapshot {
+    long long frame = 0;
+
+    long long liveGLObjects[GL_OBJECT_TYPE_COUNT] = {};
+    long long gpuBufferBytes = 0;     // sum of the glBufferData sizes of the live buffers
+    long long uploadedBytesFrame = 0; // last frame
+    long long uploadedBytesTotal = 0;
+
+    bool heapTracked = false;           // built with TELEMETRY_HEAP_HOOKS
+    long long heapAllocationsFrame = 0; // last frame
+    long long heapAllocationsTotal = 0;
+    long long heapBytesFrame = 0;       // allocated during the last frame
+    long long liveHeapBytes = 0;
+
+    // worst frame since the previous dump
+    long long maxUploadedBytesFrame = 0;
+    long long maxHeapAllocationsFrame = 0;
+
+    long long residentBytes = -1; // -1 if unknown on this platform
+};
+
+// ### GL OBJECTS ###
+// same arguments as the GL functions
+
+void tracked_gen_buffers(GLsizei count, GLuint* buffers);
+void tracked_delete_buffers(GLsizei count, const GLuint* buffers);
+void tracked_gen_vertex_arrays(GLsizei count, GLuint* arrays);
+void tracked_delete_vertex_arrays(GLsizei count, const GLuint* arrays);
+GLuint tracked_create_shader(GLenum type);
+void tracked_delete_shader(GLuint shader);
+GLuint tracked_create_program();
+void tracked_delete_program(GLuint program);
+
+// glBufferData on the buffer bound to target, buffer is its name (memory held per buffer)
+void tracked_buffer_data(GLenum target, GLuint buffer, GLsizeiptr size, const void* data, GLenum usage);
+
+const char* gl_object_type_name(GLObjectType type);
+
+// ### FRAMES ###
+
+// once per frame, after the swap
+void telemetry_end_frame();
+
+// last published snapshot (with the current resident set size), thread safe
+TelemetrySnapshot telemetry_snapshot();
+
+// -1 if unknown on this platform
+long long resident_set_bytes();
+
+// print the snapshot and start a new max period
+void telemetry_print();
+
+// ### ENDPOINT ###
+
+// serve the snapshot as plain text metrics (Prometheus text format) over HTTP on 127.0.0.1:port
+// and / or a Unix socket (empty path / port 0 -> not served). Returns false if it could not listen.
+bool telemetry_start_server(int port, const std::string& socketPath);
+void telemetry_stop_server();
@@ -0,0 +1,73 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+
+WorkerPool::~WorkerPool(){
+    stop();
+}
+
+void WorkerPool::start(int threadCount){
+    stop();
+    m_stopping = false;
+    m_threadCount = std::max(1, threadCount);
+    for(int t = 0; t < m_threadCount - 1; t++){
+        m_threads.push_back(std::thread(&WorkerPool::worker_loop, this, t));
+    }
+}
+
+void WorkerPool::stop(){
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workReady.notify_all();
+    for(size_t t = 0; t < m_threads.size(); t++){
+        m_threads[t].join();
+    }
+    m_threads.clear();
+    m_threadCount = 1;
+}
+
+void WorkerPool::run(const std::function< void(int) >& work){
+    if(m_threads.empty()){
+        work(0);
+        return;
+    }
+
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        m_work = &work;
+        m_pending = (int)m_threads.size();
+        m_generation++;
+    }
+    m_workReady.notify_all();
+
+    work(m_threadCount - 1);
+
+    std::unique_lock< std::mutex > lock(m_mutex);
+    m_workDone.wait(lock, [this]() { return m_pending == 0; });
+    m_work = nullptr;
+}
+
+void WorkerPool::worker_loop(int thread){
+    unsigned generation = 0;
+    for(;;){
+        const std::function< void(int) >* work;
+        {
+            std::unique_lock< std::mutex > lock(m_mutex);
+            m_workReady.wait(lock, [this, generation]() { return m_stopping || m_generation != generation; });
+            if(m_stopping){
+                return;
+            }
+            generation = m_generation;
+            work = m_work;
+        }
+
+        (*work)(thread);
+
+        std::lock_guard< std::mutex > lock(m_mutex);
+        if(--m_pending == 0){
+            m_workDone.notify_one();
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Threads started once and reused for every parallel stage (creating threads each frame costs more than
+// a small frame). run() hands the same work to every thread and returns when all of them finished it.
+class WorkerPool {
+public:
+    WorkerPool() {}
+    ~WorkerPool();
+
+    // threadCount - 1 workers, the thread calling run() is the last one
+    void start(int threadCount);
+
+    int thread_count() const { return m_threadCount; }
+
+    // work(t) for every t in [0, thread_count()), the calling thread runs t = thread_count() - 1
+    void run(const std::function< void(int) >& work);
+
+private:
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void worker_loop(int thread);
+    void stop();
+
+    int m_threadCount = 1;
+    std::vector< std::thread > m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_workReady;
+    std::condition_variable m_workDone;
+    const std::function< void(int) >* m_work = nullptr;
+    unsigned m_generation = 0; // incremented by every run(), the workers wait for a new one
+    int m_pending = 0;         // workers still running the current work
+    bool m_stopping = false;
+};
@@ -0,0 +1,71 @@
+#include <cstdio>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "animation.h"
+#include "models.h"
+
+// Step curves hold their value exactly up to each key, both evaluated from the keys and from the tables.
+
+static int g_failures = 0;
+
+static void expect_equal(const char* what, float time, float value, float expected){
+    if(value != expected){
+        std::printf("FAILED %s at %.4f s : %.6f, expected %.6f\n", what, time, value, expected);
+        g_failures++;
+    }
+}
+
+static float evaluate_channel(AnimationSystem& animation, std::vector< LetterIDModel >& models, float time){
+    animation.evaluate(time, models);
+    return models[0].spinAngle;
+}
+
+static void test_step_curve(bool loop){
+    // irregular key times, not on the 1/256 grid of a fixed table
+    AnimationCurve curve;
+    curve.interpolation = CURVE_STEP;
+    curve.loop = loop;
+    curve.keys = { {0.0f, 10.0f}, {0.3f, 20.0f}, {0.7f, 30.0f}, {1.3f, 40.0f}, {2.0f, 50.0f} };
+
+    AnimationSystem animation;
+    int id = animation.add_curve(curve);
+    std::vector< LetterIDModel > models(1, LetterIDModel(nullptr, glm::mat4(1.0f)));
+    animation.animate(0, AnimationSystem::CHANNEL_SPIN, id);
+
+    const char* name = loop ? "looping step curve" : "step curve";
+    for(size_t k = 1; k < curve.keys.size(); k++){
+        float keyTime = curve.keys[k].time;
+        float before = curve.keys[k - 1].value;
+        float after = curve.keys[k].value;
+
+        // up to the key : the previous value, no ramp
+        for(float epsilon : { 0.1f, 0.01f, 0.001f, 0.0001f }){
+            expect_equal(name, keyTime - epsilon, evaluate_curve(curve, keyTime - epsilon), before);
+            expect_equal(name, keyTime - epsilon, evaluate_channel(animation, models, keyTime - epsilon), before);
+        }
+
+        // right after the key : the new value (the last key of a loop wraps to the first one)
+        float next = (loop && k + 1 == curve.keys.size()) ? curve.keys[0].value : after;
+        expect_equal(name, keyTime + 0.0001f, evaluate_curve(curve, keyTime + 0.0001f), next);
+        expect_equal(name, keyTime + 0.0001f, evaluate_channel(animation, models, keyTime + 0.0001f), next);
+    }
+
+    // the second loop / the held last key
+    float later = loop ? 10.0f : 50.0f;
+    expect_equal(name, 2.2f, evaluate_channel(animation, models, 2.2f), later);
+    expect_equal(name, 5.0f, evaluate_channel(animation, models, 5.0f), loop ? 30.0f : 50.0f);
+}
+
+int main(){
+    test_step_curve(false);
+    test_step_curve(true);
+
+    if(g_failures > 0){
+        std::printf("%d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::printf("animation tests passed\n");
+    return 0;
+}